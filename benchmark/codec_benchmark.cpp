@@ -0,0 +1,170 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+// Compares the generic serialize() and deserialize() functions with the CompiledCodec for deeply nested message
+// types consisting mostly of fixed-size members.
+//
+// Usage: codec_benchmark [<number of messages>] [<number of runs>]
+
+#include "byte_packing.hpp"
+#include "codec.hpp"
+#include "simple.hpp"
+#include "streams.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Timestamp {
+  uint32_t seconds;
+  uint32_t nanoseconds;
+};
+
+struct Price {
+  int64_t mantissa;
+  int32_t exponent;
+  uint32_t flags;
+};
+
+struct Level {
+  Price price;
+  uint64_t quantity;
+  uint32_t numOrders;
+  uint32_t flags;
+};
+
+struct BookSide {
+  std::array<Level, 5> levels;
+  Timestamp updated;
+  uint32_t depth;
+  uint32_t flags;
+};
+
+struct Instrument {
+  std::array<char, 12> symbol;
+  uint32_t id;
+  uint16_t market;
+  uint16_t type;
+};
+
+struct Statistics {
+  Price open;
+  Price high;
+  Price low;
+  Price close;
+  uint64_t volume;
+};
+
+struct Header {
+  Timestamp sent;
+  uint64_t sequence;
+  uint32_t channel;
+  uint32_t flags;
+};
+
+struct Snapshot {
+  Header header;
+  Instrument instrument;
+  BookSide bids;
+  BookSide asks;
+  Statistics statistics;
+  std::string venue;
+};
+
+static Snapshot createSnapshot(uint32_t index) {
+  Snapshot snapshot{};
+  snapshot.header = Header{{1700000000 + index, index * 1000}, index, index % 4, 0};
+  snapshot.instrument = Instrument{{'A', 'C', 'M', 'E'}, index % 100, 7, 1};
+  for (uint32_t i = 0; i < snapshot.bids.levels.size(); ++i) {
+    snapshot.bids.levels[i] = Level{{10000 - i, -2, 0}, 100 * (i + 1), i + 1, 0};
+    snapshot.asks.levels[i] = Level{{10001 + i, -2, 0}, 50 * (i + 1), i + 2, 0};
+  }
+  snapshot.bids.depth = snapshot.asks.depth = 5;
+  snapshot.statistics = Statistics{{9900, -2, 0}, {10100, -2, 0}, {9800, -2, 0}, {10000, -2, 0}, 123456789};
+  snapshot.venue = "XNAS";
+  return snapshot;
+}
+
+template <typename Func> static double measure(std::size_t numRuns, std::size_t numMessages, Func&& func) {
+  std::vector<double> durations{};
+  for (std::size_t run = 0; run < numRuns; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    durations.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+  }
+  return *std::min_element(durations.begin(), durations.end()) / static_cast<double>(numMessages);
+}
+
+template <typename S, typename D>
+static void compare(const std::string& name, const std::vector<Snapshot>& messages, std::size_t numRuns) {
+  using Codec = serialize::CompiledCodec<S, Snapshot>;
+  serialize::BufferOutputStream out{};
+  uint64_t checksum = 0;
+
+  auto encodeGeneric = measure(numRuns, messages.size(), [&] {
+    out.reset();
+    S serializer{out};
+    for (const auto& message : messages) {
+      serialize::serialize(serializer, message);
+    }
+    serializer.flush();
+  });
+  auto decodeGeneric = measure(numRuns, messages.size(), [&] {
+    serialize::SpanInputStream in{out.data()};
+    D deserializer{in};
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+      checksum += serialize::deserialize<Snapshot>(deserializer).header.sequence;
+    }
+  });
+
+  auto encodeCompiled = measure(numRuns, messages.size(), [&] {
+    out.reset();
+    S serializer{out};
+    for (const auto& message : messages) {
+      Codec::encode(serializer, message);
+    }
+    serializer.flush();
+  });
+  auto decodeCompiled = measure(numRuns, messages.size(), [&] {
+    serialize::SpanInputStream in{out.data()};
+    D deserializer{in};
+    Snapshot message{};
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+      Codec::decodeInto(deserializer, message);
+      checksum += message.header.sequence;
+    }
+  });
+
+  std::cout << name << " (" << Codec::NUM_OPERATIONS << " operations, " << Codec::NUM_BLOCKS
+            << " blocks, checksum " << checksum << ")" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "  Encode: " << encodeGeneric << " ns generic, " << encodeCompiled << " ns compiled ("
+            << (encodeGeneric / encodeCompiled) << "x)" << std::endl;
+  std::cout << "  Decode: " << decodeGeneric << " ns generic, " << decodeCompiled << " ns compiled ("
+            << (decodeGeneric / decodeCompiled) << "x)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  const std::size_t numMessages = argc > 1 ? std::stoul(argv[1]) : 100000;
+  const std::size_t numRuns = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  std::vector<Snapshot> messages{};
+  messages.reserve(numMessages);
+  for (std::size_t i = 0; i < numMessages; ++i) {
+    messages.push_back(createSnapshot(static_cast<uint32_t>(i)));
+  }
+
+  std::cout << "Encoding and decoding " << numMessages << " nested snapshot messages (time per message)" << std::endl;
+  compare<serialize::SimpleStreamSerializer, serialize::SimpleStreamDeserializer>("Simple", messages, numRuns);
+  compare<serialize::BytePackingSinkSerializer, serialize::BytePackingSourceDeserializer>("BytePacking", messages,
+                                                                                          numRuns);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+// Measures the time (and with Clang the number of template instantiations) required to compile the corpus of large
+// aggregate types in compile_time_corpus.cpp with the compiler used to build this program.
+//
+// Usage: compile_time_benchmark [<number of runs>] [<number of types per shape>]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::string readFile(const std::filesystem::path& path) {
+  std::ifstream in{path};
+  return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+static std::size_t countOccurrences(const std::string& haystack, const std::string& needle) {
+  std::size_t count = 0;
+  for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size())) {
+    ++count;
+  }
+  return count;
+}
+
+/**
+ * Extracts the time spent on template instantiation from the output of GCC's -ftime-report.
+ */
+static std::optional<std::string> findInstantiationTime(const std::string& timeReport) {
+  std::istringstream in{timeReport};
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.find("template instantiation") != std::string::npos) {
+      return line.substr(line.find_first_not_of(' '));
+    }
+  }
+  return {};
+}
+
+int main(int argc, char** argv) {
+  const std::size_t numRuns = argc > 1 ? std::stoul(argv[1]) : 5;
+  const std::size_t typesPerShape = argc > 2 ? std::stoul(argv[2]) : 8;
+  if (numRuns == 0) {
+    std::cerr << "Usage: " << argv[0] << " [<number of runs>] [<number of types per shape>]" << std::endl;
+    std::cerr << "The number of runs needs to be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string compilerId = SERIALIZE_CXX_COMPILER_ID;
+  const bool isClang = compilerId.find("Clang") != std::string::npos;
+  const bool isGcc = compilerId == "GNU";
+
+  auto tempDir = std::filesystem::temp_directory_path();
+  auto objectFile = tempDir / "serialize_compile_time_corpus.o";
+  auto reportFile = tempDir / "serialize_compile_time_corpus.txt";
+
+  std::string command = std::string{"\""} + SERIALIZE_CXX_COMPILER + "\" -std=c++20 -I\"" + SERIALIZE_INCLUDE_DIR +
+                        "\" -DCORPUS_TYPES_PER_SHAPE=" + std::to_string(typesPerShape) + " -c \"" + CORPUS_SOURCE +
+                        "\" -o \"" + objectFile.string() + "\"";
+  if (isClang) {
+    // writes the trace next to the object file
+    command += " -ftime-trace";
+  } else if (isGcc) {
+    command += " -ftime-report";
+  }
+  command += " 2> \"" + reportFile.string() + "\"";
+
+  std::vector<double> durations{};
+  std::string report;
+  for (std::size_t run = 0; run < numRuns; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    if (std::system(command.c_str()) != 0) {
+      std::cerr << "Failed to compile corpus: " << command << std::endl;
+      std::cerr << readFile(reportFile) << std::endl;
+      return EXIT_FAILURE;
+    }
+    durations.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  if (isClang) {
+    report = readFile(objectFile.replace_extension(".json"));
+  } else {
+    report = readFile(reportFile);
+  }
+
+  std::sort(durations.begin(), durations.end());
+  std::cout << "Compiled corpus of " << (4 * typesPerShape) << " aggregate types (8 to 64 members) " << numRuns
+            << " times with " << compilerId << std::endl;
+  std::cout << "  Minimum time: " << durations.front() << " s" << std::endl;
+  std::cout << "  Median time:  " << durations[durations.size() / 2] << " s" << std::endl;
+  if (isClang) {
+    std::cout << "  Class template instantiations:    " << countOccurrences(report, "\"name\":\"InstantiateClass\"")
+              << std::endl;
+    std::cout << "  Function template instantiations: " << countOccurrences(report, "\"name\":\"InstantiateFunction\"")
+              << std::endl;
+  } else if (auto time = findInstantiationTime(report)) {
+    std::cout << "  " << *time << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
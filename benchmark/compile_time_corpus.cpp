@@ -0,0 +1,73 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+// Corpus of large aggregate types for measuring the compile-time overhead of the structured bindings support, see
+// compile_time_benchmark.cpp.
+
+#include "byte_packing.hpp"
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "simple.hpp"
+#include "skip.hpp"
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#ifndef CORPUS_TYPES_PER_SHAPE
+#define CORPUS_TYPES_PER_SHAPE 8
+#endif
+
+// The message types are templates only to create many distinct types, all of which are probed separately.
+template <std::size_t Id> struct Message8 {
+  uint32_t u0, u1, u2, u3;
+  double d0, d1;
+  std::string s0, s1;
+};
+
+template <std::size_t Id> struct Message24 {
+  uint8_t u0, u1, u2, u3, u4, u5, u6, u7;
+  int32_t i0, i1, i2, i3, i4, i5, i6, i7;
+  float f0, f1, f2, f3, f4, f5, f6, f7;
+};
+
+template <std::size_t Id> struct Message40 {
+  uint16_t u0, u1, u2, u3, u4, u5, u6, u7, u8, u9;
+  int64_t i0, i1, i2, i3, i4, i5, i6, i7, i8, i9;
+  double d0, d1, d2, d3, d4, d5, d6, d7, d8, d9;
+  bool b0, b1, b2, b3, b4, b5, b6, b7, b8, b9;
+};
+
+template <std::size_t Id> struct Message64 {
+  uint8_t u0, u1, u2, u3, u4, u5, u6, u7, u8, u9, u10, u11, u12, u13, u14, u15;
+  int32_t i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15;
+  uint64_t l0, l1, l2, l3, l4, l5, l6, l7, l8, l9, l10, l11, l12, l13, l14, l15;
+  double d0, d1, d2, d3, d4, d5, d6, d7, d8, d9, d10, d11, d12, d13, d14, d15;
+};
+
+template <typename T, typename S, typename D> std::size_t roundTrip() {
+  std::stringstream ss{};
+  S serializer{ss};
+  serialize::serialize(serializer, T{});
+  serializer.flush();
+  D deserializer{ss};
+  [[maybe_unused]] auto result = serialize::deserialize<T>(deserializer);
+  serialize::skip<T>(deserializer);
+  return ss.str().size();
+}
+
+template <typename T> std::size_t roundTripAll() {
+  return roundTrip<T, serialize::SimpleStreamSerializer, serialize::SimpleStreamDeserializer>() +
+         roundTrip<T, serialize::BytePackingSinkSerializer, serialize::BytePackingSourceDeserializer>();
+}
+
+template <std::size_t... Ids> std::size_t roundTripCorpus(std::index_sequence<Ids...>) {
+  return (... + (roundTripAll<Message8<Ids>>() + roundTripAll<Message24<Ids>>() + roundTripAll<Message40<Ids>>() +
+                 roundTripAll<Message64<Ids>>()));
+}
+
+std::size_t roundTripCorpus() { return roundTripCorpus(std::make_index_sequence<CORPUS_TYPES_PER_SHAPE>{}); }
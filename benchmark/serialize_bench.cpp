@@ -0,0 +1,284 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+// Measures the throughput, output size and heap allocations of encoding and decoding representative value shapes with
+// all serializer backends and writes the results as JSON, e.g. to compare them across versions.
+//
+// Usage: serialize_bench [--output <JSON file>] [--min-time <seconds per measurement>] [--filter <substring>]
+
+#include "allocation_tracking.hpp"
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+#include "streams.hpp"
+#include "type_safe.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+struct DataContainer {
+  int8_t sb;
+  uint8_t ub;
+  int16_t ss;
+  uint16_t us;
+  int32_t si;
+  uint32_t ui;
+  int64_t sl;
+  uint64_t ul;
+
+  float f;
+  double d;
+  long double ld;
+
+  char c;
+  wchar_t w;
+  char8_t u8;
+  char16_t u16;
+  char32_t u32;
+
+  bool b;
+
+  std::string s;
+  std::vector<std::byte> v;
+
+  auto operator<=>(const DataContainer& other) const noexcept = default;
+};
+
+/**
+ * Owns the serializer of the given type writing to a stream, including any wrapped inner serializer.
+ */
+template <typename S> struct Writer {
+  explicit Writer(std::ostream& out) : serializer(out) {}
+
+  S serializer;
+};
+
+template <typename Inner> struct Writer<serialize::TypeSafeSerializer<Inner>> {
+  explicit Writer(std::ostream& out) : inner(out), serializer(inner) {}
+
+  Inner inner;
+  serialize::TypeSafeSerializer<Inner> serializer;
+};
+
+template <typename D> struct Reader {
+  explicit Reader(std::istream& in) : deserializer(in) {}
+
+  D deserializer;
+};
+
+template <typename Inner> struct Reader<serialize::TypeSafeDeserializer<Inner>> {
+  explicit Reader(std::istream& in) : inner(in), deserializer(inner) {}
+
+  Inner inner;
+  serialize::TypeSafeDeserializer<Inner> deserializer;
+};
+
+struct Result {
+  std::string backend;
+  std::string shape;
+  std::size_t encodedSize;
+  double encodeSeconds;
+  double decodeSeconds;
+  double encodeAllocations;
+  double decodeAllocations;
+  // whether the decoded values are equal to the encoded ones
+  bool valid;
+};
+
+struct Options {
+  std::string output;
+  double minTime = 0.2;
+  std::string filter;
+};
+
+/**
+ * Runs the given function (processing the given number of values) repeatedly with increasing batch sizes until the
+ * minimum time is reached and returns the time per value and the allocations per value.
+ */
+template <typename Func>
+static std::pair<double, double> measure(double minTime, std::size_t valuesPerRun, Func&& func) {
+  // warm up, e.g. to grow buffers to their final size
+  func(1);
+  for (std::size_t numRuns = 1;; numRuns *= 2) {
+    AllocationTracker tracker{};
+    auto start = std::chrono::steady_clock::now();
+    func(numRuns);
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto allocations = static_cast<double>(tracker.statistics().numAllocations);
+    auto numValues = static_cast<double>(numRuns * valuesPerRun);
+    if (duration >= minTime) {
+      return std::make_pair(duration / numValues, allocations / numValues);
+    }
+  }
+}
+
+template <typename S, typename D, typename T>
+static void run(const Options& options, std::vector<Result>& results, const std::string& backend,
+                const std::string& shape, const T& value) {
+  if (!options.filter.empty() && (backend + "/" + shape).find(options.filter) == std::string::npos) {
+    return;
+  }
+  // encode multiple values per run to also measure the setup of the (de)serializers, but not let it dominate
+  constexpr std::size_t VALUES_PER_RUN = 16;
+
+  serialize::BufferOutputStream out{};
+  auto [encodeSeconds, encodeAllocations] = measure(options.minTime, VALUES_PER_RUN, [&](std::size_t numRuns) {
+    for (std::size_t run = 0; run < numRuns; ++run) {
+      out.reset();
+      Writer<S> writer{out};
+      for (std::size_t i = 0; i < VALUES_PER_RUN; ++i) {
+        serialize::serialize(writer.serializer, value);
+      }
+      writer.serializer.flush();
+    }
+  });
+
+  bool allEqual = true;
+  auto [decodeSeconds, decodeAllocations] = measure(options.minTime, VALUES_PER_RUN, [&](std::size_t numRuns) {
+    for (std::size_t run = 0; run < numRuns; ++run) {
+      serialize::SpanInputStream in{out.data()};
+      Reader<D> reader{in};
+      for (std::size_t i = 0; i < VALUES_PER_RUN; ++i) {
+        allEqual = serialize::deserialize<T>(reader.deserializer) == value && allEqual;
+      }
+    }
+  });
+  if (!allEqual) {
+    std::cerr << "Decoded values differ for " << backend << "/" << shape << std::endl;
+  }
+
+  results.push_back(Result{backend, shape, out.data().size() / VALUES_PER_RUN, encodeSeconds, decodeSeconds,
+                           encodeAllocations, decodeAllocations, allEqual});
+}
+
+template <typename S, typename D>
+static void runShapes(const Options& options, std::vector<Result>& results, const std::string& backend) {
+  run<S, D>(options, results, backend, "scalar_u64", uint64_t{0x0123456789ABCDEF});
+  run<S, D>(options, results, backend, "scalar_double", 3.14159265358979);
+
+  std::vector<int> numbers(1000);
+  for (std::size_t i = 0; i < numbers.size(); ++i) {
+    numbers[i] = static_cast<int>(i * i % 100003) - 50000;
+  }
+  run<S, D>(options, results, backend, "vector_int", numbers);
+
+  std::vector<std::string> strings{};
+  std::map<std::string, uint32_t> map{};
+  for (uint32_t i = 0; i < 100; ++i) {
+    strings.push_back("string value number " + std::to_string(i));
+    map.emplace("key" + std::to_string(i), i * 31);
+  }
+  run<S, D>(options, results, backend, "strings", strings);
+  run<S, D>(options, results, backend, "map", map);
+
+  DataContainer container{-3, 17, -1234, 12345, -654321, 543213440, -3751985643563665, 43759353465875, -17.0f,
+                          4365477356385674763.34563, 4357357985453435.43568463578623562, 'a', L'b', u8'A', u'c', U'd',
+                          true, "Foo", std::vector<std::byte>(64, std::byte{0x17})};
+  run<S, D>(options, results, backend, "data_container", container);
+
+  std::vector<std::variant<int32_t, double, std::string>> variants{};
+  for (int32_t i = 0; i < 100; ++i) {
+    if (i % 3 == 0) {
+      variants.emplace_back(i);
+    } else if (i % 3 == 1) {
+      variants.emplace_back(i * 0.5);
+    } else {
+      variants.emplace_back(std::to_string(i));
+    }
+  }
+  run<S, D>(options, results, backend, "variants", variants);
+}
+
+static void writeJson(std::ostream& out, const std::vector<Result>& results) {
+  out << "{\n";
+  out << "  \"compiler\": \"" << SERIALIZE_CXX_COMPILER_ID << "\",\n";
+  out << "  \"build_type\": \"" << SERIALIZE_BUILD_TYPE << "\",\n";
+  out << "  \"results\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const auto& result = results[i];
+    auto encodedBytes = static_cast<double>(result.encodedSize);
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\"backend\": \"" << result.backend << "\", \"shape\": \"" << result.shape << "\", ";
+    out << "\"encoded_size\": " << result.encodedSize << ", ";
+    out << "\"encode_mb_per_s\": " << (encodedBytes / result.encodeSeconds / 1e6) << ", ";
+    out << "\"decode_mb_per_s\": " << (encodedBytes / result.decodeSeconds / 1e6) << ", ";
+    out << "\"encode_values_per_s\": " << (1.0 / result.encodeSeconds) << ", ";
+    out << "\"decode_values_per_s\": " << (1.0 / result.decodeSeconds) << ", ";
+    out << "\"encode_allocations_per_op\": " << result.encodeAllocations << ", ";
+    out << "\"decode_allocations_per_op\": " << result.decodeAllocations << ", ";
+    out << "\"valid\": " << (result.valid ? "true" : "false") << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+static int printUsage(const char* program) {
+  std::cerr << "Usage: " << program << " [--output <JSON file>] [--min-time <seconds>] [--filter <substring>]"
+            << std::endl;
+  return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv) {
+  Options options{};
+  for (int i = 1; i < argc; i += 2) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      // e.g. --help or an option missing its value
+      return printUsage(argv[0]);
+    } else if (arg == "--output") {
+      options.output = argv[i + 1];
+    } else if (arg == "--min-time") {
+      try {
+        std::size_t end = 0;
+        options.minTime = std::stod(argv[i + 1], &end);
+        if (argv[i + 1][end] != '\0' || !(options.minTime >= 0.0)) {
+          return printUsage(argv[0]);
+        }
+      } catch (const std::exception&) {
+        // std::invalid_argument or std::out_of_range
+        return printUsage(argv[0]);
+      }
+    } else if (arg == "--filter") {
+      options.filter = argv[i + 1];
+    } else {
+      return printUsage(argv[0]);
+    }
+  }
+
+  using namespace serialize;
+  std::vector<Result> results{};
+  runShapes<SimpleStreamSerializer, SimpleStreamDeserializer>(options, results, "simple");
+  runShapes<BitPackingSinkSerializer, BitPackingSourceDeserializer>(options, results, "bit_packing");
+  runShapes<BytePackingSinkSerializer, BytePackingSourceDeserializer>(options, results, "byte_packing");
+  runShapes<TypeSafeSerializer<SimpleStreamSerializer>, TypeSafeDeserializer<SimpleStreamDeserializer>>(
+      options, results, "type_safe_simple");
+  runShapes<TypeSafeSerializer<BitPackingSinkSerializer>, TypeSafeDeserializer<BitPackingSourceDeserializer>>(
+      options, results, "type_safe_bit_packing");
+  runShapes<TypeSafeSerializer<BytePackingSinkSerializer>, TypeSafeDeserializer<BytePackingSourceDeserializer>>(
+      options, results, "type_safe_byte_packing");
+
+  if (options.output.empty()) {
+    writeJson(std::cout, results);
+  } else {
+    std::ofstream out{options.output};
+    writeJson(out, results);
+    if (!out.flush()) {
+      std::cerr << "Failed to write results to " << options.output << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << results.size() << " results to " << options.output << std::endl;
+  }
+  // the measurements of values not decoded correctly are meaningless
+  auto allValid = std::ranges::all_of(results, [](const Result& result) { return result.valid; });
+  return allValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,171 @@
+/*
+ * Standard streams moving the actual I/O operations to background threads.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    class AsyncWriteBuffer : public std::streambuf {
+    public:
+      using WriteData = std::function<void(std::span<const std::byte>)>;
+      using SyncData = std::function<void()>;
+
+      AsyncWriteBuffer(WriteData&& writeData, SyncData&& syncData, std::size_t bufferSize, std::size_t numBuffers);
+      AsyncWriteBuffer(const AsyncWriteBuffer&) = delete;
+      AsyncWriteBuffer(AsyncWriteBuffer&&) noexcept = delete;
+      ~AsyncWriteBuffer() noexcept override;
+
+      AsyncWriteBuffer& operator=(const AsyncWriteBuffer&) = delete;
+      AsyncWriteBuffer& operator=(AsyncWriteBuffer&&) noexcept = delete;
+
+    protected:
+      int_type overflow(int_type ch) override;
+      int sync() override;
+
+    private:
+      struct Job {
+        std::size_t buffer;
+        std::size_t size;
+        bool sync;
+      };
+
+      void submit(bool sync);
+      void acquireBuffer(std::unique_lock<std::mutex>& lock);
+      void waitForCompletion(std::unique_lock<std::mutex>& lock);
+      void run();
+
+      WriteData writeData;
+      SyncData syncData;
+      std::vector<std::vector<char>> buffers;
+      std::vector<std::size_t> freeBuffers;
+      std::deque<Job> jobs;
+      std::size_t currentBuffer;
+      std::size_t numSubmitted;
+      std::size_t numCompleted;
+      std::exception_ptr error;
+      bool stopping;
+      std::mutex mutex;
+      std::condition_variable condition;
+      std::thread worker;
+    };
+
+    class AsyncReadBuffer : public std::streambuf {
+    public:
+      using ReadData = std::function<std::size_t(std::span<std::byte>)>;
+
+      AsyncReadBuffer(ReadData&& readData, std::size_t bufferSize, std::size_t numBuffers);
+      AsyncReadBuffer(const AsyncReadBuffer&) = delete;
+      AsyncReadBuffer(AsyncReadBuffer&&) noexcept = delete;
+      ~AsyncReadBuffer() noexcept override;
+
+      AsyncReadBuffer& operator=(const AsyncReadBuffer&) = delete;
+      AsyncReadBuffer& operator=(AsyncReadBuffer&&) noexcept = delete;
+
+    protected:
+      int_type underflow() override;
+
+    private:
+      static constexpr std::size_t NO_BUFFER = static_cast<std::size_t>(-1);
+
+      struct Block {
+        std::size_t buffer;
+        std::size_t size;
+      };
+
+      void run();
+
+      ReadData readData;
+      std::vector<std::vector<char>> buffers;
+      std::vector<std::size_t> freeBuffers;
+      std::deque<Block> readyBlocks;
+      std::size_t currentBuffer;
+      std::exception_ptr error;
+      bool endOfInput;
+      bool stopping;
+      std::mutex mutex;
+      std::condition_variable condition;
+      std::thread worker;
+    };
+  } // namespace detail
+
+  /**
+   * Output stream writing the data to the underlying sink on a background thread.
+   *
+   * The written data is collected in a fixed number of fixed-size buffers. Whenever a buffer is full, it is handed over
+   * to the background thread, which writes it to the underlying sink, while the writing thread continues to fill the
+   * next buffer. If all buffers are in use, the writing thread blocks until the background thread has drained a buffer,
+   * so memory usage is bounded.
+   *
+   * Flushing the stream (e.g. via std::flush or #flush()) blocks until all data written so far is persisted, i.e. is
+   * written to the underlying sink and the sink is flushed (for std::ostream sinks) or synchronized to the storage
+   * device (for file descriptor sinks).
+   *
+   * Errors writing to the underlying sink are reported on the next buffer hand-over or flush by setting the badbit.
+   */
+  class AsyncOutputStream : private detail::AsyncWriteBuffer, public std::ostream {
+  public:
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+    /**
+     * Creates a stream writing to the given output stream, which needs to outlive this object.
+     */
+    explicit AsyncOutputStream(std::ostream& sink, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                               std::size_t numBuffers = 2);
+
+    /**
+     * Creates a stream writing to the given file descriptor, which needs to be kept open for the lifetime of this
+     * object.
+     */
+    explicit AsyncOutputStream(int fileDescriptor, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                               std::size_t numBuffers = 2);
+  };
+
+  /**
+   * Input stream reading the data ahead from the underlying source on a background thread.
+   *
+   * The background thread keeps reading the next blocks of data into a fixed number of fixed-size buffers, while the
+   * reading thread consumes the previously read buffers, thus keeping up to (numBuffers - 1) * bufferSize bytes ready
+   * to be consumed without waiting for the underlying source.
+   *
+   * The stream does not support seeking or putting back characters beyond the current buffer. Since the data is read
+   * ahead, the position of the underlying source is unspecified after this stream is destroyed.
+   *
+   * Errors reading from the underlying source are reported after all data read before the error is consumed by
+   * setting the badbit.
+   */
+  class AsyncInputStream : private detail::AsyncReadBuffer, public std::istream {
+  public:
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+    /**
+     * Creates a stream reading from the given input stream, which needs to outlive this object.
+     */
+    explicit AsyncInputStream(std::istream& source, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                              std::size_t numBuffers = 4);
+
+    /**
+     * Creates a stream reading from the given file descriptor, which needs to be kept open for the lifetime of this
+     * object.
+     */
+    explicit AsyncInputStream(int fileDescriptor, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                              std::size_t numBuffers = 4);
+  };
+
+} // namespace serialize
@@ -10,6 +10,7 @@
 #include "deserialize.hpp"
 #include "serialize.hpp"
 
+#include <climits>
 #include <functional>
 #include <iostream>
 
@@ -46,8 +47,25 @@ namespace serialize {
     void write(intmax_t val);
     void write(uintmax_t val);
 
+    void splice(BitPackingSinkSerializer&& other, std::span<const std::byte> data);
+
     void flush();
 
+    /**
+     * Returns the maximum number of bits written for a single value of the given fundamental type.
+     */
+    template <typename T> static constexpr std::size_t maxEncodedBits() noexcept {
+      // the Exp-Golomb code for values of N bits (plus sign bit) has at most 2N + 1 bits
+      constexpr auto codeFor = [](std::size_t numBits) { return 2 * numBits + 1; };
+      if constexpr (std::is_same_v<T, long double>) {
+        return sizeof(long double) / sizeof(uint64_t) * codeFor(std::numeric_limits<uint64_t>::digits);
+      } else if constexpr (std::is_floating_point_v<T>) {
+        return codeFor(sizeof(T) * CHAR_BIT);
+      } else {
+        return codeFor(std::numeric_limits<T>::digits + (std::is_signed_v<T> ? 1 : 0));
+      }
+    }
+
   private:
     SinkByte sink;
     BitCache cache;
@@ -78,7 +96,33 @@ namespace serialize {
     void read(intmax_t& val);
     void read(uintmax_t& val);
 
+    template <typename T> std::enable_if_t<std::is_integral_v<T>, bool> tryRead(T& val) {
+      using MaxIntType = std::conditional_t<std::is_signed_v<T>, intmax_t, uintmax_t>;
+      MaxIntType tmp = 0;
+      if (!tryRead(tmp)) {
+        return false;
+      }
+      val = static_cast<T>(tmp);
+      return true;
+    }
+
+    bool tryRead(float& val);
+    bool tryRead(double& val);
+    bool tryRead(long double& val);
+
+    bool tryRead(intmax_t& val);
+    bool tryRead(uintmax_t& val);
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues) {
+      // long double values are written as multiple 64-bit codes
+      constexpr std::size_t CODES_PER_VALUE =
+          std::is_same_v<T, long double> ? sizeof(long double) / sizeof(uint64_t) : 1;
+      skipCodes(numValues * CODES_PER_VALUE);
+    }
+
   private:
+    void skipCodes(std::size_t numCodes);
+
     SourceByte source;
     BitCache cache;
   };
@@ -0,0 +1,246 @@
+/*
+ * Compile-time upper bounds of the serialized size of fixed-shape types and allocation-free encoding into buffers.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "serialize.hpp"
+#include "simple.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <complex>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace serialize {
+
+  /**
+   * Concept for serializers providing the maximum number of bits written for a single value of any fundamental type.
+   */
+  template <typename S>
+  concept BoundedSerializer = Serializer<S> && requires {
+    { S::template maxEncodedBits<uint64_t>() } -> std::convertible_to<std::size_t>;
+  };
+
+  namespace detail {
+    using OptionalBits = std::optional<std::size_t>;
+
+    constexpr OptionalBits addBits(OptionalBits first, OptionalBits second) noexcept {
+      if (first && second) {
+        return *first + *second;
+      }
+      return {};
+    }
+
+    constexpr OptionalBits maxBits(OptionalBits first, OptionalBits second) noexcept {
+      if (first && second) {
+        return std::max(*first, *second);
+      }
+      return {};
+    }
+
+    template <typename... Bits> constexpr OptionalBits sumOfBits(Bits... bits) noexcept {
+      OptionalBits result = 0;
+      ((result = addBits(result, bits)), ...);
+      return result;
+    }
+
+    template <typename... Bits> constexpr OptionalBits maxOfBits(Bits... bits) noexcept {
+      OptionalBits result = 0;
+      ((result = maxBits(result, bits)), ...);
+      return result;
+    }
+
+    /**
+     * Maximum number of bits written for the given type, empty for types without fixed upper bound (e.g. growable
+     * containers) or with custom serialization functions.
+     */
+    template <typename Format, typename T> struct MaxSerializedBits {
+      static constexpr OptionalBits value{};
+    };
+
+    template <typename Format, typename T>
+    constexpr OptionalBits maxSerializedBits = MaxSerializedBits<Format, std::remove_cv_t<T>>::value;
+
+    template <typename Format, typename T>
+      requires(std::is_arithmetic_v<T>)
+    struct MaxSerializedBits<Format, T> {
+      static constexpr OptionalBits value = Format::template maxEncodedBits<T>();
+    };
+
+    template <typename Format> struct MaxSerializedBits<Format, std::byte> : MaxSerializedBits<Format, uint8_t> {};
+
+    template <typename Format, typename T>
+    struct MaxSerializedBits<Format, std::atomic<T>> : MaxSerializedBits<Format, T> {};
+
+    template <typename Format, typename R, typename P>
+    struct MaxSerializedBits<Format, std::chrono::duration<R, P>> : MaxSerializedBits<Format, R> {};
+
+    template <typename Format, typename C, typename D>
+    struct MaxSerializedBits<Format, std::chrono::time_point<C, D>> : MaxSerializedBits<Format, typename D::rep> {};
+
+    template <typename Format, typename T> struct MaxSerializedBits<Format, std::complex<T>> {
+      static constexpr OptionalBits value = addBits(maxSerializedBits<Format, T>, maxSerializedBits<Format, T>);
+    };
+
+    template <typename Format, typename T> struct MaxSerializedBits<Format, std::optional<T>> {
+      static constexpr OptionalBits value = addBits(maxSerializedBits<Format, bool>, maxSerializedBits<Format, T>);
+    };
+
+    template <typename Format, typename T, std::size_t N> struct MaxSerializedBits<Format, std::array<T, N>> {
+      static constexpr OptionalBits value = [] {
+        if constexpr (ByteSerializer<Format> && SerializableRawData<std::array<T, N>>) {
+          // written as raw memory
+          return addBits(maxSerializedBits<Format, std::size_t>, N * sizeof(T) * CHAR_BIT);
+        } else {
+          OptionalBits result = maxSerializedBits<Format, std::size_t>;
+          for (std::size_t i = 0; i < N; ++i) {
+            result = addBits(result, maxSerializedBits<Format, T>);
+          }
+          return result;
+        }
+      }();
+    };
+
+    template <typename Format, std::size_t N> struct MaxSerializedBits<Format, std::bitset<N>> {
+      static constexpr OptionalBits value = [] {
+        if constexpr (!std::is_same_v<EnclosingUnsignedType<N>, void>) {
+          return maxSerializedBits<Format, EnclosingUnsignedType<N>>;
+        } else {
+          OptionalBits result = 0;
+          for (std::size_t i = 0; i < (N + 7) / 8; ++i) {
+            result = addBits(result, maxSerializedBits<Format, uint8_t>);
+          }
+          return result;
+        }
+      }();
+    };
+
+    template <typename Format, typename... Types> struct MaxSerializedBits<Format, std::tuple<Types...>> {
+      static constexpr OptionalBits value = sumOfBits(maxSerializedBits<Format, Types>...);
+    };
+
+    template <typename Format, typename F, typename S>
+    struct MaxSerializedBits<Format, std::pair<F, S>> : MaxSerializedBits<Format, std::tuple<F, S>> {};
+
+    template <typename Format, typename... Types> struct MaxSerializedBits<Format, std::variant<Types...>> {
+      static constexpr OptionalBits value =
+          addBits(maxSerializedBits<Format, std::size_t>, maxOfBits(maxSerializedBits<Format, Types>...));
+    };
+
+    template <typename Format, typename T>
+      requires(ReflectableAggregate<T> && std::is_standard_layout_v<T> && !is_member_serializable<Format, T> &&
+               !is_static_member_serializable<Format, T>)
+    struct MaxSerializedBits<Format, T> {
+      static constexpr OptionalBits value = MaxSerializedBits<Format, MemberTypes<T>>::value;
+    };
+  } // namespace detail
+
+  /**
+   * Concept for types whose serialized size with the given serializer type has a compile-time upper bound, i.e.
+   * fundamental types, std::array, std::bitset, std::optional, std::pair, std::tuple, std::variant and aggregates of
+   * these types.
+   */
+  template <typename T, typename Format>
+  concept BoundedSerializable = BoundedSerializer<Format> && detail::maxSerializedBits<Format, T>.has_value();
+
+  /**
+   * The maximum number of bytes written when serializing a single value of the given type with the given serializer
+   * type (including flushing any pending bits).
+   */
+  template <BoundedSerializer Format, BoundedSerializable<Format> T>
+  constexpr std::size_t maxSerializedSize = (*detail::maxSerializedBits<Format, T> + CHAR_BIT - 1) / CHAR_BIT;
+
+  namespace detail {
+    /**
+     * Serializer writing the same output as the SimpleStreamSerializer into a buffer known to be large enough.
+     */
+    class UncheckedNativeSerializer {
+    public:
+      explicit UncheckedNativeSerializer(std::byte* out) noexcept : out(out) {}
+
+      template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) noexcept {
+        std::memcpy(out, &val, sizeof(T));
+        out += sizeof(T);
+      }
+
+      void write(std::size_t numElements, std::span<const std::byte> data) noexcept {
+        write(numElements);
+        std::memcpy(out, data.data(), data.size());
+        out += data.size();
+      }
+
+      void flush() noexcept {}
+
+      std::byte* position() const noexcept { return out; }
+
+    private:
+      std::byte* out;
+    };
+  } // namespace detail
+
+  /**
+   * Encoder serializing values of the given type with the encoding of the given serializer type into an internal
+   * buffer of the maximum serialized size.
+   *
+   * Since the buffer can hold any value of the type, no bounds are checked and no memory is allocated, i.e. the
+   * encoder can be placed on the stack and reused for any number of values.
+   */
+  template <BoundedSerializer Format, BoundedSerializable<Format> T>
+    requires(std::same_as<Format, SimpleStreamSerializer> ||
+             std::constructible_from<Format, std::function<void(std::byte)>&&>)
+  class StackEncoder {
+  public:
+    static constexpr std::size_t CAPACITY = maxSerializedSize<Format, T>;
+
+    /**
+     * Encodes the given value, replacing the previously encoded value, and returns the encoded data.
+     */
+    std::span<const std::byte> encode(const T& value) {
+      if constexpr (std::same_as<Format, SimpleStreamSerializer>) {
+        detail::UncheckedNativeSerializer serializer{buffer.data()};
+        serialize(serializer, value);
+        numBytes = static_cast<std::size_t>(serializer.position() - buffer.data());
+        assert(numBytes <= CAPACITY);
+      } else {
+        numBytes = 0;
+        // the lambda only captures a pointer and is therefore stored inline in the std::function
+        Format serializer{[this](std::byte byte) {
+          assert(numBytes < CAPACITY);
+          buffer[numBytes++] = byte;
+        }};
+        serialize(serializer, value);
+        serializer.flush();
+      }
+      return data();
+    }
+
+    /**
+     * Returns the data of the last encoded value.
+     */
+    std::span<const std::byte> data() const noexcept { return std::span<const std::byte>{buffer.data(), numBytes}; }
+
+  private:
+    // not initialized, only the encoded bytes are ever read
+    std::array<std::byte, CAPACITY> buffer;
+    std::size_t numBytes = 0;
+  };
+
+} // namespace serialize
@@ -0,0 +1,162 @@
+/*
+ * Block-wise checksums of the serialized data of other (de-)serializers for detecting data corruption.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "skip.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <streambuf>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * Calculates the CRC-32C (Castagnoli) checksum of the given data, continuing the given previous checksum.
+     *
+     * Uses the dedicated CPU instructions (SSE4.2 on x86-64, CRC extension on ARMv8) if supported by the CPU running
+     * the program and a slicing-by-8 software implementation otherwise.
+     */
+    uint32_t crc32c(std::span<const std::byte> data, uint32_t previous = 0) noexcept;
+
+    /**
+     * Software-only version of crc32c() using the slicing-by-8 algorithm.
+     */
+    uint32_t crc32cSoftware(std::span<const std::byte> data, uint32_t previous = 0) noexcept;
+
+    class ChecksummingStreamBuffer : public std::streambuf {
+    public:
+      ChecksummingStreamBuffer(std::ostream& out, std::size_t blockSize);
+      ChecksummingStreamBuffer(const ChecksummingStreamBuffer&) = delete;
+      ChecksummingStreamBuffer(ChecksummingStreamBuffer&&) noexcept = delete;
+      ~ChecksummingStreamBuffer() noexcept override;
+
+      ChecksummingStreamBuffer& operator=(const ChecksummingStreamBuffer&) = delete;
+      ChecksummingStreamBuffer& operator=(ChecksummingStreamBuffer&&) noexcept = delete;
+
+    protected:
+      int_type overflow(int_type ch) override;
+      int sync() override;
+
+    private:
+      void writeBlock();
+
+      std::ostream& out;
+      std::vector<char> block;
+    };
+
+    class VerifyingStreamBuffer : public std::streambuf {
+    public:
+      VerifyingStreamBuffer(std::istream& in, std::size_t maxBlockSize);
+
+    protected:
+      int_type underflow() override;
+
+    private:
+      std::istream& in;
+      std::size_t maxBlockSize;
+      std::vector<std::byte> block;
+    };
+  } // namespace detail
+
+  /**
+   * Output stream splitting the written data into blocks and writing each block prefixed with its size and CRC-32C
+   * checksum to the underlying stream.
+   *
+   * Flushing this stream writes the (partial) current block and flushes the underlying stream.
+   */
+  class ChecksummedOutputStream : private detail::ChecksummingStreamBuffer, public std::ostream {
+  public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ChecksummedOutputStream(std::ostream& out, std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+  };
+
+  /**
+   * Input stream reading the data written by a ChecksummedOutputStream, verifying the checksum of each block before
+   * making any of its data available.
+   *
+   * Checksum mismatches and blocks larger than the given maximum block size (i.e. corrupted block sizes) are reported by
+   * setting the badbit. The maximum block size needs to be at least the block size used for writing the data.
+   */
+  class ChecksummedInputStream : private detail::VerifyingStreamBuffer, public std::istream {
+  public:
+    explicit ChecksummedInputStream(std::istream& in,
+                                    std::size_t maxBlockSize = ChecksummedOutputStream::DEFAULT_BLOCK_SIZE);
+  };
+
+  /**
+   * Serializer adding block-wise checksums to the output of the wrapped Serializer type.
+   *
+   * NOTE: This serializer requires proper usage of the #flush() function.
+   */
+  template <Serializer S>
+    requires(std::constructible_from<S, std::ostream&>)
+  class ChecksummedSerializer {
+  public:
+    explicit ChecksummedSerializer(std::ostream& os,
+                                   std::size_t blockSize = ChecksummedOutputStream::DEFAULT_BLOCK_SIZE)
+        : stream(os, blockSize), serializer(stream) {}
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) { serializer.write(val); }
+
+    void write(std::size_t numElements, std::span<const std::byte> data)
+      requires ByteSerializer<S>
+    {
+      serializer.write(numElements, data);
+    }
+
+    void flush() {
+      serializer.flush();
+      stream.flush();
+    }
+
+  private:
+    ChecksummedOutputStream stream;
+    S serializer;
+  };
+
+  /**
+   * Deserializer verifying the block-wise checksums written by a ChecksummedSerializer before passing the data to the
+   * wrapped Deserializer type.
+   *
+   * Corrupted data is reported by throwing a std::domain_error. The maximum block size needs to be at least the block
+   * size of the ChecksummedSerializer writing the data.
+   */
+  template <Deserializer D>
+    requires(std::constructible_from<D, std::istream&>)
+  class ChecksummedDeserializer {
+  public:
+    explicit ChecksummedDeserializer(std::istream& is,
+                                     std::size_t maxBlockSize = ChecksummedOutputStream::DEFAULT_BLOCK_SIZE)
+        : stream(is, maxBlockSize), deserializer(stream) {
+      // report checksum errors as-is instead of just setting the badbit
+      stream.exceptions(std::ios_base::badbit);
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> read(T& val) { deserializer.read(val); }
+
+    template <typename T>
+    std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues)
+      requires SkippingDeserializer<D>
+    {
+      deserializer.template skip<T>(numValues);
+    }
+
+  private:
+    ChecksummedInputStream stream;
+    D deserializer;
+  };
+
+} // namespace serialize
@@ -0,0 +1,341 @@
+/*
+ * Codecs compiled per type and serializer into flat sequences of encode and decode operations.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+#include "serialize.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace serialize {
+
+  namespace detail {
+    [[noreturn]] void throwOnFixedSizeMismatch(std::size_t expected, std::size_t actual);
+
+    /**
+     * Returns the element with the given index of the given tuple-like, fixed-size container or aggregate object.
+     */
+    template <std::size_t Index, typename T> constexpr auto& elementAt(T& object) {
+      if constexpr (TupleType<std::remove_const_t<T>> || is_fixed_size_container_v<std::remove_const_t<T>>) {
+        return std::get<Index>(object);
+      } else {
+        return memberAt<Index>(object);
+      }
+    }
+
+    template <typename T> constexpr T& elementAtPath(T& object) { return object; }
+
+    /**
+     * Returns the (nested) element at the given path of element indices of the given object.
+     */
+    template <std::size_t First, std::size_t... Rest, typename T> constexpr auto& elementAtPath(T& object) {
+      return elementAtPath<Rest...>(elementAt<First>(object));
+    }
+
+    template <typename T, std::size_t Index>
+    using ElementType = std::remove_cvref_t<decltype(elementAt<Index>(std::declval<T&>()))>;
+
+    /**
+     * Operation for a fundamental value at the given path.
+     */
+    template <typename Path, typename V> struct ValueLeaf;
+
+    template <std::size_t... Path, typename V> struct ValueLeaf<std::index_sequence<Path...>, V> {
+      static constexpr std::size_t NATIVE_SIZE = sizeof(V);
+
+      template <typename S, typename T> static void write(S& serializer, const T& object) {
+        serialize(serializer, elementAtPath<Path...>(object));
+      }
+
+      template <typename D, typename T> static void read(D& deserializer, T& object) {
+        deserializeInto(deserializer, elementAtPath<Path...>(object));
+      }
+
+      template <typename T> static void store(std::byte* out, const T& object) noexcept {
+        std::memcpy(out, &elementAtPath<Path...>(object), sizeof(V));
+      }
+
+      template <typename T> static void load(const std::byte* in, T& object) noexcept {
+        std::memcpy(&elementAtPath<Path...>(object), in, sizeof(V));
+      }
+    };
+
+    /**
+     * Operation for the compile-time constant size of a fixed-size container serialized element-wise.
+     */
+    template <std::size_t N> struct ConstantLeaf {
+      static constexpr std::size_t NATIVE_SIZE = sizeof(std::size_t);
+
+      template <typename S, typename T> static void write(S& serializer, const T& /* object */) {
+        serialize(serializer, N);
+      }
+
+      template <typename D, typename T> static void read(D& deserializer, T& /* object */) {
+        check(deserialize<std::size_t>(deserializer));
+      }
+
+      template <typename T> static void store(std::byte* out, const T& /* object */) noexcept {
+        const std::size_t size = N;
+        std::memcpy(out, &size, sizeof(std::size_t));
+      }
+
+      template <typename T> static void load(const std::byte* in, T& /* object */) {
+        std::size_t size = 0;
+        std::memcpy(&size, in, sizeof(std::size_t));
+        check(size);
+      }
+
+    private:
+      static void check(std::size_t size) {
+        if (size != N) {
+          throwOnFixedSizeMismatch(N, size);
+        }
+      }
+    };
+
+    /**
+     * Operation for a fixed-size container of trivial values at the given path written as raw memory.
+     */
+    template <typename Path, typename A> struct RawLeaf;
+
+    template <std::size_t... Path, typename A> struct RawLeaf<std::index_sequence<Path...>, A> {
+      static constexpr std::size_t NUM_ELEMENTS = std::tuple_size_v<A>;
+      static constexpr std::size_t NUM_BYTES = NUM_ELEMENTS * sizeof(typename A::value_type);
+      static constexpr std::size_t NATIVE_SIZE = sizeof(std::size_t) + NUM_BYTES;
+
+      template <typename S, typename T> static void write(S& serializer, const T& object) {
+        serialize(serializer, elementAtPath<Path...>(object));
+      }
+
+      template <typename D, typename T> static void read(D& deserializer, T& object) {
+        deserializeInto(deserializer, elementAtPath<Path...>(object));
+      }
+
+      template <typename T> static void store(std::byte* out, const T& object) noexcept {
+        ConstantLeaf<NUM_ELEMENTS>::store(out, object);
+        std::memcpy(out + sizeof(std::size_t), elementAtPath<Path...>(object).data(), NUM_BYTES);
+      }
+
+      template <typename T> static void load(const std::byte* in, T& object) {
+        ConstantLeaf<NUM_ELEMENTS>::load(in, object);
+        std::memcpy(elementAtPath<Path...>(object).data(), in + sizeof(std::size_t), NUM_BYTES);
+      }
+    };
+
+    /**
+     * Operation for a value at the given path without fixed native size, (de)serialized via the generic functions.
+     */
+    template <typename Path, typename V> struct NestedLeaf;
+
+    template <std::size_t... Path, typename V> struct NestedLeaf<std::index_sequence<Path...>, V> {
+      template <typename S, typename T> static void write(S& serializer, const T& object) {
+        serialize(serializer, elementAtPath<Path...>(object));
+      }
+
+      template <typename D, typename T> static void read(D& deserializer, T& object) {
+        deserializeInto(deserializer, elementAtPath<Path...>(object));
+      }
+    };
+
+    template <typename Leaf>
+    concept FixedLeaf = requires { Leaf::NATIVE_SIZE; };
+
+    template <typename Leaf> constexpr std::size_t nativeSize() noexcept {
+      if constexpr (FixedLeaf<Leaf>) {
+        return Leaf::NATIVE_SIZE;
+      } else {
+        return 0;
+      }
+    }
+
+    /**
+     * Flattened tuple of the operations (de)serializing the value of the given type at the given path the same way the
+     * generic serialize() and deserialize() functions do for the given serializer type.
+     */
+    template <typename Format, typename T, typename Path> struct CodecLeaves {
+      using type = std::tuple<NestedLeaf<Path, T>>;
+    };
+
+    template <typename Format, typename T, typename Path, typename Indices> struct ElementLeaves;
+
+    template <typename Format, typename T, std::size_t... Path, std::size_t... Indices>
+    struct ElementLeaves<Format, T, std::index_sequence<Path...>, std::index_sequence<Indices...>> {
+      template <std::size_t Index>
+      using Leaves = typename CodecLeaves<Format, ElementType<T, Index>, std::index_sequence<Path..., Index>>::type;
+
+      using type = decltype(std::tuple_cat(std::declval<Leaves<Indices>>()...));
+    };
+
+    template <typename Format, typename T, typename Path>
+      requires(std::is_arithmetic_v<T> || std::is_same_v<T, std::byte>)
+    struct CodecLeaves<Format, T, Path> {
+      using type = std::tuple<ValueLeaf<Path, T>>;
+    };
+
+    template <typename Format, typename E, std::size_t N, typename Path>
+    struct CodecLeaves<Format, std::array<E, N>, Path> {
+      using Elements = typename ElementLeaves<Format, std::array<E, N>, Path, std::make_index_sequence<N>>::type;
+      using type = decltype(std::tuple_cat(std::declval<std::tuple<ConstantLeaf<N>>>(), std::declval<Elements>()));
+    };
+
+    template <typename Format, typename E, std::size_t N, typename Path>
+      requires(ByteSerializer<Format> && SerializableRawData<std::array<E, N>>)
+    struct CodecLeaves<Format, std::array<E, N>, Path> {
+      using type = std::tuple<RawLeaf<Path, std::array<E, N>>>;
+    };
+
+    template <typename Format, typename... Types, typename Path>
+    struct CodecLeaves<Format, std::tuple<Types...>, Path>
+        : ElementLeaves<Format, std::tuple<Types...>, Path, std::index_sequence_for<Types...>> {};
+
+    template <typename Format, typename F, typename S, typename Path>
+    struct CodecLeaves<Format, std::pair<F, S>, Path>
+        : ElementLeaves<Format, std::pair<F, S>, Path, std::index_sequence<0, 1>> {};
+
+    template <typename Format, typename T, typename Path>
+      requires(ReflectableAggregate<T> && is_structured_bindings_serializable<Format, T> &&
+               StructuredBindingDeserializable<T>)
+    struct CodecLeaves<Format, T, Path> : ElementLeaves<Format, T, Path, std::make_index_sequence<memberCount<T>>> {};
+  } // namespace detail
+
+  /**
+   * Codec (de)serializing values of the given type with the given serializer type (and the matching deserializer
+   * types) via a flat sequence of operations determined at compile time.
+   *
+   * The nested structure of aggregates, tuples, pairs and fixed-size arrays is resolved once at compile time into
+   * operations on the contained fundamental values, eliminating the nested overload resolution and member dispatch
+   * of the generic serialize() and deserialize() functions. Any other (e.g. dynamically sized) values are still
+   * (de)serialized via the generic functions. For serializers writing the native representation (see
+   * NativeBlockSerializer), adjacent fixed-size values (including the constant sizes of fixed-size arrays) are merged
+   * into single block writes and reads.
+   *
+   * The encoded data is identical to the data written by the generic serialize() function and can be read by the
+   * generic deserialize() function and vice versa, except that the sizes of fixed-size arrays are required to match.
+   */
+  template <Serializer Format, typename T> class CompiledCodec {
+    using Leaves = typename detail::CodecLeaves<Format, T, std::index_sequence<>>::type;
+
+  public:
+    /**
+     * The number of operations the value is encoded with.
+     */
+    static constexpr std::size_t NUM_OPERATIONS = std::tuple_size_v<Leaves>;
+
+  private:
+    static constexpr std::array<bool, NUM_OPERATIONS> IS_FIXED =
+        []<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          return std::array<bool, NUM_OPERATIONS>{detail::FixedLeaf<std::tuple_element_t<Indices, Leaves>>...};
+        }(std::make_index_sequence<NUM_OPERATIONS>{});
+
+    /**
+     * The offsets of the native representations of all operations, with the non-fixed operations taking up no space.
+     */
+    static constexpr std::array<std::size_t, NUM_OPERATIONS + 1> OFFSETS = [] {
+      std::array<std::size_t, NUM_OPERATIONS + 1> offsets{};
+      [&offsets]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+        ((offsets[Indices + 1] = offsets[Indices] + detail::nativeSize<std::tuple_element_t<Indices, Leaves>>()), ...);
+      }(std::make_index_sequence<NUM_OPERATIONS>{});
+      return offsets;
+    }();
+
+  public:
+
+    /**
+     * The number of merged blocks of fixed-size values written at once (for native serializers only).
+     */
+    static constexpr std::size_t NUM_BLOCKS = [] {
+      std::size_t numBlocks = 0;
+      if constexpr (NativeBlockSerializer<Format>) {
+        for (std::size_t i = 0; i < NUM_OPERATIONS; ++i) {
+          numBlocks += IS_FIXED[i] && (i == 0 || !IS_FIXED[i - 1]) ? 1 : 0;
+        }
+      }
+      return numBlocks;
+    }();
+
+    static void encode(Format& serializer, const T& value) {
+      if constexpr (NativeBlockSerializer<Format>) {
+        encodeBlocks<0>(serializer, value);
+      } else {
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          (std::tuple_element_t<Indices, Leaves>::write(serializer, value), ...);
+        }(std::make_index_sequence<NUM_OPERATIONS>{});
+      }
+    }
+
+    template <Deserializer D> static void decodeInto(D& deserializer, T& value) {
+      if constexpr (NativeBlockSerializer<Format> && NativeBlockDeserializer<D>) {
+        decodeBlocks<0>(deserializer, value);
+      } else {
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          (std::tuple_element_t<Indices, Leaves>::read(deserializer, value), ...);
+        }(std::make_index_sequence<NUM_OPERATIONS>{});
+      }
+    }
+
+    template <Deserializer D> static T decode(D& deserializer) {
+      T value{};
+      decodeInto(deserializer, value);
+      return value;
+    }
+
+  private:
+    static constexpr std::size_t blockEnd(std::size_t begin) noexcept {
+      while (begin < NUM_OPERATIONS && IS_FIXED[begin]) {
+        ++begin;
+      }
+      return begin;
+    }
+
+    template <std::size_t Begin> static void encodeBlocks(Format& serializer, const T& value) {
+      if constexpr (Begin < NUM_OPERATIONS) {
+        if constexpr (IS_FIXED[Begin]) {
+          constexpr std::size_t END = blockEnd(Begin);
+          std::array<std::byte, OFFSETS[END] - OFFSETS[Begin]> block;
+          [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+            (std::tuple_element_t<Begin + Indices, Leaves>::store(
+                 block.data() + (OFFSETS[Begin + Indices] - OFFSETS[Begin]), value),
+             ...);
+          }(std::make_index_sequence<END - Begin>{});
+          serializer.writeNative(block);
+          encodeBlocks<END>(serializer, value);
+        } else {
+          std::tuple_element_t<Begin, Leaves>::write(serializer, value);
+          encodeBlocks<Begin + 1>(serializer, value);
+        }
+      }
+    }
+
+    template <std::size_t Begin, typename D> static void decodeBlocks(D& deserializer, T& value) {
+      if constexpr (Begin < NUM_OPERATIONS) {
+        if constexpr (IS_FIXED[Begin]) {
+          constexpr std::size_t END = blockEnd(Begin);
+          std::array<std::byte, OFFSETS[END] - OFFSETS[Begin]> block;
+          deserializer.readNative(block);
+          [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+            (std::tuple_element_t<Begin + Indices, Leaves>::load(
+                 block.data() + (OFFSETS[Begin + Indices] - OFFSETS[Begin]), value),
+             ...);
+          }(std::make_index_sequence<END - Begin>{});
+          decodeBlocks<END>(deserializer, value);
+        } else {
+          std::tuple_element_t<Begin, Leaves>::read(deserializer, value);
+          decodeBlocks<Begin + 1>(deserializer, value);
+        }
+      }
+    }
+  };
+
+} // namespace serialize
@@ -0,0 +1,333 @@
+/*
+ * Columnar (struct-of-arrays) serialization of containers of aggregate types.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "skip.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * The encodings used for the single member columns.
+   */
+  enum class ColumnEncoding : uint8_t {
+    /**
+     * All values of the column are written as a single raw memory block (for ByteSerializer types only).
+     */
+    RAW = 0,
+    /**
+     * The (zig-zag encoded) differences between consecutive integral values are written, e.g. for timestamps or IDs.
+     */
+    DELTA = 1,
+    /**
+     * The minimum integral value is written, followed by the offsets of all values from that minimum.
+     */
+    FRAME_OF_REFERENCE = 2,
+    /**
+     * The exclusive-or of the bit patterns of consecutive floating-point values is written without its trailing zero
+     * bits.
+     */
+    XOR = 3,
+    /**
+     * All values of the column are serialized one after the other, e.g. for strings or nested aggregates.
+     */
+    PLAIN = 4
+  };
+
+  namespace detail {
+    template <typename T>
+    constexpr bool is_integral_column_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+    template <typename T>
+    constexpr bool is_floating_column_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    constexpr uint64_t encodeZigZag(int64_t value) noexcept {
+      return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    constexpr int64_t decodeZigZag(uint64_t value) noexcept {
+      return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    /**
+     * Returns the signed difference of the given integral values as 64-bit integer, wrapping at the bounds of the
+     * value type.
+     */
+    template <typename T> constexpr int64_t wrappingDelta(T value, T previous) noexcept {
+      using Unsigned = std::make_unsigned_t<T>;
+      using Signed = std::make_signed_t<T>;
+      return static_cast<Signed>(static_cast<Unsigned>(static_cast<Unsigned>(value) - static_cast<Unsigned>(previous)));
+    }
+
+    /**
+     * Returns the unsigned offset of the given integral value from the given (not larger) minimum value.
+     */
+    template <typename T> constexpr uint64_t wrappingOffset(T value, T minimum) noexcept {
+      using Unsigned = std::make_unsigned_t<T>;
+      return static_cast<Unsigned>(static_cast<Unsigned>(value) - static_cast<Unsigned>(minimum));
+    }
+
+    template <typename T> constexpr T wrappingAdd(T value, int64_t delta) noexcept {
+      using Unsigned = std::make_unsigned_t<T>;
+      return static_cast<T>(static_cast<Unsigned>(static_cast<Unsigned>(value) + static_cast<Unsigned>(delta)));
+    }
+
+    [[noreturn]] void throwOnInvalidColumnEncoding(uint8_t encoding);
+    [[noreturn]] void throwOnColumnSizeMismatch(std::size_t expectedSize, std::size_t actualSize);
+
+    template <typename T, Serializer S> void writeIntegralColumn(S& serializer, const std::vector<T>& column) {
+      // estimate the encoded size of both encodings by the number of significant bits
+      std::size_t deltaBits = 0;
+      std::size_t offsetBits = 0;
+      T previous{};
+      T minimum = column.empty() ? T{} : *std::ranges::min_element(column);
+      for (auto value : column) {
+        deltaBits += static_cast<std::size_t>(std::bit_width(encodeZigZag(wrappingDelta(value, previous))));
+        offsetBits += static_cast<std::size_t>(std::bit_width(wrappingOffset(value, minimum)));
+        previous = value;
+      }
+      if (offsetBits < deltaBits) {
+        serialize(serializer, static_cast<uint8_t>(ColumnEncoding::FRAME_OF_REFERENCE));
+        serialize(serializer, minimum);
+        for (auto value : column) {
+          serialize(serializer, wrappingOffset(value, minimum));
+        }
+      } else {
+        serialize(serializer, static_cast<uint8_t>(ColumnEncoding::DELTA));
+        previous = T{};
+        for (auto value : column) {
+          serialize(serializer, encodeZigZag(wrappingDelta(value, previous)));
+          previous = value;
+        }
+      }
+    }
+
+    template <typename T, Serializer S> void writeFloatingColumn(S& serializer, const std::vector<T>& column) {
+      using Bits = EnclosingUnsignedType<sizeof(T) * 8>;
+      serialize(serializer, static_cast<uint8_t>(ColumnEncoding::XOR));
+      Bits previous = 0;
+      for (auto value : column) {
+        auto bits = std::bit_cast<Bits>(value);
+        auto diff = static_cast<Bits>(bits ^ previous);
+        // the bits of similar values only differ in the middle of the mantissa
+        auto shift = static_cast<uint8_t>(std::countr_zero(diff));
+        serialize(serializer, shift);
+        if (diff) {
+          serialize(serializer, static_cast<Bits>(diff >> shift));
+        }
+        previous = bits;
+      }
+    }
+
+    template <std::size_t Index, typename T, Serializer S, std::ranges::sized_range C>
+    void writeColumn(S& serializer, const C& container) {
+      using Member = std::tuple_element_t<Index, MemberTypes<T>>;
+      if constexpr (std::is_arithmetic_v<Member> && !std::is_same_v<Member, bool> &&
+                    (ByteSerializer<S> || is_integral_column_v<Member> || is_floating_column_v<Member>)) {
+        std::vector<Member> column{};
+        column.reserve(std::ranges::size(container));
+        for (const auto& element : container) {
+          column.push_back(memberAt<Index>(element));
+        }
+        if constexpr (ByteSerializer<S>) {
+          serialize(serializer, static_cast<uint8_t>(ColumnEncoding::RAW));
+          serialize(serializer, column);
+        } else if constexpr (is_integral_column_v<Member>) {
+          writeIntegralColumn(serializer, column);
+        } else {
+          writeFloatingColumn(serializer, column);
+        }
+      } else {
+        serialize(serializer, static_cast<uint8_t>(ColumnEncoding::PLAIN));
+        for (const auto& element : container) {
+          serialize(serializer, memberAt<Index>(element));
+        }
+      }
+    }
+
+    template <std::size_t Index, typename T, Deserializer D, typename C>
+    void readColumn(D& deserializer, C& container) {
+      using Member = std::tuple_element_t<Index, MemberTypes<T>>;
+      auto encoding = deserialize<uint8_t>(deserializer);
+      auto numElements = std::ranges::size(container);
+      auto checkEncoding = [encoding](bool valid) {
+        if (!valid) {
+          throwOnInvalidColumnEncoding(encoding);
+        }
+      };
+      switch (static_cast<ColumnEncoding>(encoding)) {
+      case ColumnEncoding::RAW:
+        checkEncoding(std::is_arithmetic_v<Member> && !std::is_same_v<Member, bool>);
+        if constexpr (std::is_arithmetic_v<Member> && !std::is_same_v<Member, bool>) {
+          auto column = deserialize<std::vector<Member>>(deserializer);
+          if (column.size() != numElements) {
+            throwOnColumnSizeMismatch(numElements, column.size());
+          }
+          std::size_t i = 0;
+          for (auto& element : container) {
+            memberAt<Index>(element) = column[i++];
+          }
+        }
+        break;
+      case ColumnEncoding::DELTA:
+        checkEncoding(is_integral_column_v<Member>);
+        if constexpr (is_integral_column_v<Member>) {
+          Member previous{};
+          for (auto& element : container) {
+            previous = wrappingAdd(previous, decodeZigZag(deserialize<uint64_t>(deserializer)));
+            memberAt<Index>(element) = previous;
+          }
+        }
+        break;
+      case ColumnEncoding::FRAME_OF_REFERENCE:
+        checkEncoding(is_integral_column_v<Member>);
+        if constexpr (is_integral_column_v<Member>) {
+          auto minimum = deserialize<Member>(deserializer);
+          for (auto& element : container) {
+            memberAt<Index>(element) =
+                wrappingAdd(minimum, static_cast<int64_t>(deserialize<uint64_t>(deserializer)));
+          }
+        }
+        break;
+      case ColumnEncoding::XOR:
+        checkEncoding(is_floating_column_v<Member>);
+        if constexpr (is_floating_column_v<Member>) {
+          using Bits = EnclosingUnsignedType<sizeof(Member) * 8>;
+          Bits previous = 0;
+          for (auto& element : container) {
+            auto shift = deserialize<uint8_t>(deserializer);
+            if (shift < std::numeric_limits<Bits>::digits) {
+              previous = static_cast<Bits>(previous ^ static_cast<Bits>(deserialize<Bits>(deserializer) << shift));
+            } else if (shift > std::numeric_limits<Bits>::digits) {
+              throwOnInvalidColumnEncoding(encoding);
+            }
+            memberAt<Index>(element) = std::bit_cast<Member>(previous);
+          }
+        }
+        break;
+      case ColumnEncoding::PLAIN:
+        for (auto& element : container) {
+          deserializeInto(deserializer, memberAt<Index>(element));
+        }
+        break;
+      default:
+        throwOnInvalidColumnEncoding(encoding);
+      }
+    }
+
+    template <std::size_t Index, typename T, Deserializer D>
+    void skipColumn(D& deserializer, std::size_t numElements) {
+      using Member = std::tuple_element_t<Index, MemberTypes<T>>;
+      auto encoding = deserialize<uint8_t>(deserializer);
+      switch (static_cast<ColumnEncoding>(encoding)) {
+      case ColumnEncoding::RAW:
+        if constexpr (std::is_arithmetic_v<Member> && !std::is_same_v<Member, bool>) {
+          skip<std::vector<Member>>(deserializer);
+          break;
+        }
+        throwOnInvalidColumnEncoding(encoding);
+      case ColumnEncoding::DELTA:
+        if constexpr (is_integral_column_v<Member>) {
+          skipValues<uint64_t>(deserializer, numElements);
+          break;
+        }
+        throwOnInvalidColumnEncoding(encoding);
+      case ColumnEncoding::FRAME_OF_REFERENCE:
+        if constexpr (is_integral_column_v<Member>) {
+          skip<Member>(deserializer);
+          skipValues<uint64_t>(deserializer, numElements);
+          break;
+        }
+        throwOnInvalidColumnEncoding(encoding);
+      case ColumnEncoding::XOR:
+        if constexpr (is_floating_column_v<Member>) {
+          using Bits = EnclosingUnsignedType<sizeof(Member) * 8>;
+          for (std::size_t i = 0; i < numElements; ++i) {
+            if (deserialize<uint8_t>(deserializer) < std::numeric_limits<Bits>::digits) {
+              skipValues<Bits>(deserializer, 1);
+            }
+          }
+          break;
+        }
+        throwOnInvalidColumnEncoding(encoding);
+      case ColumnEncoding::PLAIN:
+        skipElements<Member>(deserializer, numElements);
+        break;
+      default:
+        throwOnInvalidColumnEncoding(encoding);
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Serializes the given container of aggregates column-wise, i.e. all values of the first member followed by all
+   * values of the second member, etc.
+   *
+   * Each column is encoded in the most compact way supported by the member type and the serializer: ByteSerializer
+   * types write columns of arithmetic values as single raw memory blocks, other serializers write integral columns
+   * with delta or frame-of-reference encoding (whichever is smaller) and floating-point columns with XOR encoding.
+   * Columns of all other types (e.g. strings or nested aggregates) are serialized value by value.
+   *
+   * The data can only be deserialized with deserializeColumnar() (or skipped with skipColumnar()).
+   */
+  template <Serializer S, std::ranges::sized_range C>
+    requires(detail::ReflectableAggregate<std::ranges::range_value_t<C>>)
+  void serializeColumnar(S& serializer, const C& container) {
+    using Element = std::ranges::range_value_t<C>;
+    serialize(serializer, std::ranges::size(container));
+    [&serializer, &container]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+      (detail::writeColumn<Indices, Element>(serializer, container), ...);
+    }(std::make_index_sequence<detail::memberCount<Element>>{});
+  }
+
+  /**
+   * Deserializes a container of aggregates written by serializeColumnar().
+   *
+   * The container type needs to be resizable (e.g. a std::vector or std::deque) and the aggregate type needs to be
+   * default-constructible. Malformed column encodings are reported by throwing a std::domain_error.
+   */
+  template <typename C, Deserializer D>
+    requires(std::ranges::sized_range<C> && detail::ReflectableAggregate<std::ranges::range_value_t<C>> &&
+             requires(C container) { container.resize(std::declval<std::size_t>()); })
+  C deserializeColumnar(D& deserializer) {
+    using Element = std::ranges::range_value_t<C>;
+    C result{};
+    result.resize(deserialize<std::size_t>(deserializer));
+    [&deserializer, &result]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+      (detail::readColumn<Indices, Element>(deserializer, result), ...);
+    }(std::make_index_sequence<detail::memberCount<Element>>{});
+    return result;
+  }
+
+  /**
+   * Skips a container of aggregates written by serializeColumnar() without materializing it.
+   */
+  template <typename C, Deserializer D>
+    requires(detail::ReflectableAggregate<std::ranges::range_value_t<C>>)
+  void skipColumnar(D& deserializer) {
+    using Element = std::ranges::range_value_t<C>;
+    auto numElements = deserialize<std::size_t>(deserializer);
+    [&deserializer, numElements]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+      (detail::skipColumn<Indices, Element>(deserializer, numElements), ...);
+    }(std::make_index_sequence<detail::memberCount<Element>>{});
+  }
+
+} // namespace serialize
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <tuple>
@@ -40,6 +43,28 @@ namespace serialize {
             std::conditional_t<NumBits <= std::numeric_limits<uint32_t>::digits, uint32_t,
                                std::conditional_t<NumBits <= std::numeric_limits<uint64_t>::digits, uint64_t, void>>>>;
 
+    /**
+     * Returns whether the object representation of a std::bitset<N> consists of the packed bits in ascending order,
+     * i.e. bit 0 is the least significant bit of the first byte, which is the case for the common standard library
+     * implementations on little-endian platforms.
+     */
+    template <std::size_t N> consteval bool hasPackedBitsetLayout() {
+      if constexpr (std::endian::native != std::endian::little || !std::is_trivially_copyable_v<std::bitset<N>> ||
+                    sizeof(std::bitset<N>) < (N + 7) / 8) {
+        return false;
+      } else {
+        using Bytes = std::array<std::byte, sizeof(std::bitset<N>)>;
+        auto first = std::bit_cast<Bytes>(std::bitset<N>{0x1});
+        auto last = std::bit_cast<Bytes>(std::bitset<N>{0x8000000000000000});
+        return first[0] == std::byte{0x01} && last[7] == std::byte{0x80};
+      }
+    }
+
+    /**
+     * Number of packed bytes buffered at once when (de)serializing bit containers without accessible storage.
+     */
+    constexpr std::size_t PACKED_BITS_CHUNK_SIZE = 512;
+
     struct AnyType {
       template <class T> constexpr operator T(); // non explicit
     };
@@ -54,79 +79,439 @@ namespace serialize {
       static constexpr bool value = requires { std::decay_t<T>{std::declval<type<Sequence>>()...}; };
     };
 
-    // accepts less members -> need to check for large to small
+    // accepts less members -> the largest accepted number of initializers is the number of members
     static_assert(!HasMembers<std::pair<int, int>, 3>::value);
     static_assert(HasMembers<std::pair<int, int>, 2>::value);
     static_assert(HasMembers<std::pair<int, int>, 1>::value);
 
-    template <typename Func, typename... Args> void applyAll(Func&& func, Args&&... args) { (..., func(args)); }
+    /**
+     * Maximum number of members of aggregate types supported by applyToMembers().
+     */
+    static constexpr std::size_t MAX_MEMBER_COUNT = 64;
 
+    /**
+     * Determines the number of members of the given aggregate type via binary search over the number of initializers
+     * accepted by aggregate initialization, instantiating only logarithmically many HasMembers checks.
+     */
+    template <typename T, std::size_t Low, std::size_t High> consteval std::size_t countMembers() {
+      if constexpr (Low == High) {
+        return Low;
+      } else {
+        constexpr std::size_t Mid = (Low + High + 1) / 2;
+        if constexpr (HasMembers<T, Mid>::value) {
+          return countMembers<T, Mid, High>();
+        } else {
+          return countMembers<T, Low, Mid - 1>();
+        }
+      }
+    }
+
+    /**
+     * Number of members of the given aggregate type, probed up to one more than the supported maximum to detect
+     * unsupported types.
+     */
+    template <typename T>
+    static constexpr std::size_t memberCount = countMembers<std::remove_cvref_t<T>, 0, MAX_MEMBER_COUNT + 1>();
+
+    template <typename Func, typename... Args> constexpr void applyAll(Func&& func, Args&&... args) {
+      (..., func(args));
+    }
+
+    /**
+     * Calls the given function with all members of the given aggregate object (via structured bindings) and returns the
+     * result.
+     */
     // Adapted from https://www.reddit.com/r/cpp/comments/4yp7fv/c17_structured_bindings_convert_struct_to_a_tuple/
-    template <typename T, typename Func> void forEachMember(T&& object, Func&& func) noexcept {
-      if constexpr (HasMembers<T, 20>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17,
-                 p18, p19, p20);
-      } else if constexpr (HasMembers<T, 19>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17,
-                 p18, p19);
-      } else if constexpr (HasMembers<T, 18>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17,
-                 p18);
-      } else if constexpr (HasMembers<T, 17>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17);
-      } else if constexpr (HasMembers<T, 16>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16);
-      } else if constexpr (HasMembers<T, 15>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);
-      } else if constexpr (HasMembers<T, 14>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);
-      } else if constexpr (HasMembers<T, 13>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);
-      } else if constexpr (HasMembers<T, 12>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);
-      } else if constexpr (HasMembers<T, 11>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);
-      } else if constexpr (HasMembers<T, 10>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
-      } else if constexpr (HasMembers<T, 9>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8, p9);
-      } else if constexpr (HasMembers<T, 8>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7, p8] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7, p8);
-      } else if constexpr (HasMembers<T, 7>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6, p7] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6, p7);
-      } else if constexpr (HasMembers<T, 6>::value) {
-        auto&& [p1, p2, p3, p4, p5, p6] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5, p6);
-      } else if constexpr (HasMembers<T, 5>::value) {
-        auto&& [p1, p2, p3, p4, p5] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4, p5);
-      } else if constexpr (HasMembers<T, 4>::value) {
-        auto&& [p1, p2, p3, p4] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3, p4);
-      } else if constexpr (HasMembers<T, 3>::value) {
-        auto&& [p1, p2, p3] = object;
-        applyAll(std::forward<Func>(func), p1, p2, p3);
-      } else if constexpr (HasMembers<T, 2>::value) {
-        auto&& [p1, p2] = object;
-        applyAll(std::forward<Func>(func), p1, p2);
-      } else if constexpr (HasMembers<T, 1>::value) {
+    template <typename T, typename Func> constexpr decltype(auto) applyToMembers(T&& object, Func&& func) {
+      constexpr std::size_t Count = memberCount<T>;
+      static_assert(Count <= MAX_MEMBER_COUNT, "Aggregate types with more than 64 members are not supported");
+      if constexpr (Count == 0) {
+        return std::forward<Func>(func)();
+      } else if constexpr (Count == 1) {
         auto&& [p1] = object;
-        applyAll(std::forward<Func>(func), p1);
+        return std::forward<Func>(func)(p1);
+      } else if constexpr (Count == 2) {
+        auto&& [p1, p2] = object;
+        return std::forward<Func>(func)(p1, p2);
+      } else if constexpr (Count == 3) {
+        auto&& [p1, p2, p3] = object;
+        return std::forward<Func>(func)(p1, p2, p3);
+      } else if constexpr (Count == 4) {
+        auto&& [p1, p2, p3, p4] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4);
+      } else if constexpr (Count == 5) {
+        auto&& [p1, p2, p3, p4, p5] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5);
+      } else if constexpr (Count == 6) {
+        auto&& [p1, p2, p3, p4, p5, p6] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6);
+      } else if constexpr (Count == 7) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7);
+      } else if constexpr (Count == 8) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8);
+      } else if constexpr (Count == 9) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9);
+      } else if constexpr (Count == 10) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
+      } else if constexpr (Count == 11) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);
+      } else if constexpr (Count == 12) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);
+      } else if constexpr (Count == 13) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);
+      } else if constexpr (Count == 14) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);
+      } else if constexpr (Count == 15) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);
+      } else if constexpr (Count == 16) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16);
+      } else if constexpr (Count == 17) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17);
+      } else if constexpr (Count == 18) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17,
+                                        p18);
+      } else if constexpr (Count == 19) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19);
+      } else if constexpr (Count == 20) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20);
+      } else if constexpr (Count == 21) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20,
+                p21] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21);
+      } else if constexpr (Count == 22) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21,
+                p22] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22);
+      } else if constexpr (Count == 23) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23);
+      } else if constexpr (Count == 24) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24);
+      } else if constexpr (Count == 25) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25);
+      } else if constexpr (Count == 26) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26);
+      } else if constexpr (Count == 27) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27);
+      } else if constexpr (Count == 28) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28);
+      } else if constexpr (Count == 29) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29);
+      } else if constexpr (Count == 30) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30);
+      } else if constexpr (Count == 31) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31);
+      } else if constexpr (Count == 32) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32);
+      } else if constexpr (Count == 33) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33);
+      } else if constexpr (Count == 34) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34);
+      } else if constexpr (Count == 35) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35);
+      } else if constexpr (Count == 36) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36);
+      } else if constexpr (Count == 37) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37);
+      } else if constexpr (Count == 38) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38);
+      } else if constexpr (Count == 39) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39);
+      } else if constexpr (Count == 40) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40);
+      } else if constexpr (Count == 41) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41);
+      } else if constexpr (Count == 42) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41,
+                p42] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42);
+      } else if constexpr (Count == 43) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42,
+                p43] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43);
+      } else if constexpr (Count == 44) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44);
+      } else if constexpr (Count == 45) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45);
+      } else if constexpr (Count == 46) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46);
+      } else if constexpr (Count == 47) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47);
+      } else if constexpr (Count == 48) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48);
+      } else if constexpr (Count == 49) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49);
+      } else if constexpr (Count == 50) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50);
+      } else if constexpr (Count == 51) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51);
+      } else if constexpr (Count == 52) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52);
+      } else if constexpr (Count == 53) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53);
+      } else if constexpr (Count == 54) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54);
+      } else if constexpr (Count == 55) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55);
+      } else if constexpr (Count == 56) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56);
+      } else if constexpr (Count == 57) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57);
+      } else if constexpr (Count == 58) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58);
+      } else if constexpr (Count == 59) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58, p59] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58, p59);
+      } else if constexpr (Count == 60) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58, p59, p60] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58, p59, p60);
+      } else if constexpr (Count == 61) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61);
+      } else if constexpr (Count == 62) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61, p62] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61, p62);
+      } else if constexpr (Count == 63) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61, p62,
+                p63] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61, p62, p63);
+      } else if constexpr (Count == 64) {
+        auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22,
+                p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34, p35, p36, p37, p38, p39, p40, p41, p42, p43,
+                p44, p45, p46, p47, p48, p49, p50, p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61, p62, p63,
+                p64] = object;
+        return std::forward<Func>(func)(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18,
+                                        p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31, p32, p33, p34,
+                                        p35, p36, p37, p38, p39, p40, p41, p42, p43, p44, p45, p46, p47, p48, p49, p50,
+                                        p51, p52, p53, p54, p55, p56, p57, p58, p59, p60, p61, p62, p63, p64);
       }
     }
+
+    template <typename T, typename Func> constexpr void forEachMember(T&& object, Func&& func) {
+      applyToMembers(std::forward<T>(object), [&func](auto&... members) { applyAll(func, members...); });
+    }
+
+    struct MemberTypesCollector {
+      template <typename... Members>
+      constexpr auto operator()(Members&... /* members */) const noexcept
+          -> std::type_identity<std::tuple<std::remove_cv_t<Members>...>> {
+        return {};
+      }
+    };
+
+    /**
+     * Tuple of the (decayed) types of all members of the given aggregate type.
+     */
+    template <typename T>
+    using MemberTypes = typename decltype(applyToMembers(std::declval<T&>(), MemberTypesCollector{}))::type;
+
+    /**
+     * Concept for aggregate types (other than tuple-like types and arrays) whose members can be accessed via structured
+     * bindings.
+     */
+    template <typename T>
+    concept ReflectableAggregate = std::is_aggregate_v<T> && !TupleType<T> && !is_fixed_size_container_v<T>;
+
+    /**
+     * Returns the member with the given index of the given aggregate object.
+     */
+    template <std::size_t Index, typename T> constexpr auto& memberAt(T& object) {
+      return applyToMembers(object, [](auto&... members) -> auto& { return std::get<Index>(std::tie(members...)); });
+    }
   } // namespace detail
 } // namespace serialize
@@ -0,0 +1,249 @@
+/*
+ * Block-wise (optionally parallel) compression of the serialized data of other (de-)serializers.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "skip.hpp"
+#include "thread_pool.hpp"
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <streambuf>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * Compresses the given block of data with a LZ77-style codec into the output buffer (replacing its contents).
+     */
+    void compressBlock(std::span<const std::byte> input, std::vector<std::byte>& output);
+
+    /**
+     * Decompresses the given compressed block of data, which needs to decompress to exactly the size of the output.
+     *
+     * Throws a std::domain_error if the compressed data is malformed.
+     */
+    void decompressBlock(std::span<const std::byte> input, std::span<std::byte> output);
+
+    /**
+     * Encodes the block header (the uncompressed size and the stored size) followed by the compressed block or the
+     * uncompressed block, if compression does not reduce the size, into the encoded buffer (replacing its contents).
+     */
+    void encodeCompressedBlock(std::span<const std::byte> data, std::vector<std::byte>& encoded,
+                               std::vector<std::byte>& scratch);
+
+    /**
+     * Reads the header and the stored (possibly compressed) contents of the next block, returns false if the stream
+     * ends before the block. Blocks larger than the given maximum block size are rejected before allocating any memory.
+     */
+    bool readStoredBlock(std::istream& in, std::size_t maxBlockSize, std::size_t& blockSize,
+                         std::vector<std::byte>& stored);
+
+    /**
+     * Decompresses the stored block contents (if compressed) into the data buffer, reusing the memory of both buffers.
+     */
+    void decodeStoredBlock(std::size_t blockSize, std::vector<std::byte>& stored, std::vector<std::byte>& data);
+
+    class CompressingStreamBuffer : public std::streambuf {
+    public:
+      CompressingStreamBuffer(std::ostream& out, std::size_t blockSize, ThreadPool* pool);
+      CompressingStreamBuffer(const CompressingStreamBuffer&) = delete;
+      CompressingStreamBuffer(CompressingStreamBuffer&&) noexcept = delete;
+      ~CompressingStreamBuffer() noexcept override;
+
+      CompressingStreamBuffer& operator=(const CompressingStreamBuffer&) = delete;
+      CompressingStreamBuffer& operator=(CompressingStreamBuffer&&) noexcept = delete;
+
+    protected:
+      int_type overflow(int_type ch) override;
+      int sync() override;
+
+    private:
+      struct Block {
+        std::vector<char> data;
+        std::size_t size = 0;
+        std::vector<std::byte> encoded;
+        std::vector<std::byte> scratch;
+        std::exception_ptr error;
+        bool done = false;
+      };
+
+      void submitBlock();
+      void writeCompletedBlocks(std::size_t maxPending);
+      void waitForInFlightBlocks();
+
+      std::ostream& out;
+      std::size_t blockSize;
+      ThreadPool* pool;
+      std::unique_ptr<Block> current;
+      std::deque<std::unique_ptr<Block>> inFlight;
+      std::vector<std::unique_ptr<Block>> spareBlocks;
+      std::mutex mutex;
+      std::condition_variable condition;
+    };
+
+    class DecompressingStreamBuffer : public std::streambuf {
+    public:
+      DecompressingStreamBuffer(std::istream& in, ThreadPool* pool, std::size_t maxBlockSize);
+      DecompressingStreamBuffer(const DecompressingStreamBuffer&) = delete;
+      DecompressingStreamBuffer(DecompressingStreamBuffer&&) noexcept = delete;
+      ~DecompressingStreamBuffer() noexcept override;
+
+      DecompressingStreamBuffer& operator=(const DecompressingStreamBuffer&) = delete;
+      DecompressingStreamBuffer& operator=(DecompressingStreamBuffer&&) noexcept = delete;
+
+    protected:
+      int_type underflow() override;
+
+    private:
+      struct Block {
+        std::size_t size = 0;
+        std::vector<std::byte> stored;
+        std::vector<std::byte> data;
+        std::exception_ptr error;
+        bool done = false;
+      };
+
+      bool nextBlock();
+      void waitForInFlightBlocks();
+
+      std::istream& in;
+      ThreadPool* pool;
+      std::size_t maxBlockSize;
+      std::unique_ptr<Block> current;
+      std::deque<std::unique_ptr<Block>> inFlight;
+      std::vector<std::unique_ptr<Block>> spareBlocks;
+      std::mutex mutex;
+      std::condition_variable condition;
+    };
+  } // namespace detail
+
+  /**
+   * Output stream compressing the written data block-wise before writing it to the underlying stream.
+   *
+   * The data is collected into blocks of the given size, which are then compressed independently of each other with a
+   * fast LZ77-style codec and written to the underlying stream prefixed with a small block header. Flushing this stream
+   * writes the (partial) current block and flushes the underlying stream.
+   *
+   * If a thread pool is given, the full blocks are compressed in parallel on the pool's worker threads, while the
+   * writing thread continues to fill the next block. The compressed blocks are written in order to the underlying
+   * stream by the writing thread. The number of blocks in flight is limited to bound the memory usage. The output is
+   * identical to the output of sequential compression.
+   */
+  class CompressingOutputStream : private detail::CompressingStreamBuffer, public std::ostream {
+  public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit CompressingOutputStream(std::ostream& out, std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    CompressingOutputStream(std::ostream& out, ThreadPool& pool, std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+  };
+
+  /**
+   * Input stream decompressing the data written by a CompressingOutputStream block by block.
+   *
+   * If a thread pool is given, the blocks following the block currently read are read ahead and decompressed in
+   * parallel on the pool's worker threads. The number of blocks in flight is limited to bound the memory usage.
+   *
+   * Errors decompressing the data and blocks larger than the given maximum block size (i.e. corrupted block headers)
+   * are reported by setting the badbit. The maximum block size needs to be at least the block size used for writing the
+   * data.
+   */
+  class DecompressingInputStream : private detail::DecompressingStreamBuffer, public std::istream {
+  public:
+    explicit DecompressingInputStream(std::istream& in,
+                                      std::size_t maxBlockSize = CompressingOutputStream::DEFAULT_BLOCK_SIZE);
+    DecompressingInputStream(std::istream& in, ThreadPool& pool,
+                             std::size_t maxBlockSize = CompressingOutputStream::DEFAULT_BLOCK_SIZE);
+  };
+
+  /**
+   * Serializer compressing the output of the wrapped Serializer type block-wise.
+   *
+   * NOTE: This serializer requires proper usage of the #flush() function.
+   */
+  template <Serializer S>
+    requires(std::constructible_from<S, std::ostream&>)
+  class CompressedSerializer {
+  public:
+    explicit CompressedSerializer(std::ostream& os,
+                                  std::size_t blockSize = CompressingOutputStream::DEFAULT_BLOCK_SIZE)
+        : stream(os, blockSize), serializer(stream) {}
+    /**
+     * Creates a serializer compressing the blocks in parallel on the given thread pool.
+     */
+    CompressedSerializer(std::ostream& os, ThreadPool& pool,
+                         std::size_t blockSize = CompressingOutputStream::DEFAULT_BLOCK_SIZE)
+        : stream(os, pool, blockSize), serializer(stream) {}
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) { serializer.write(val); }
+
+    void write(std::size_t numElements, std::span<const std::byte> data)
+      requires ByteSerializer<S>
+    {
+      serializer.write(numElements, data);
+    }
+
+    void flush() {
+      serializer.flush();
+      stream.flush();
+    }
+
+  private:
+    CompressingOutputStream stream;
+    S serializer;
+  };
+
+  /**
+   * Deserializer decompressing the data written by a CompressedSerializer with the matching wrapped Serializer type.
+   *
+   * Malformed compressed data is reported by throwing a std::domain_error. The maximum block size needs to be at least
+   * the block size of the CompressedSerializer writing the data.
+   */
+  template <Deserializer D>
+    requires(std::constructible_from<D, std::istream&>)
+  class CompressedDeserializer {
+  public:
+    explicit CompressedDeserializer(std::istream& is,
+                                    std::size_t maxBlockSize = CompressingOutputStream::DEFAULT_BLOCK_SIZE)
+        : stream(is, maxBlockSize), deserializer(stream) {
+      // report decompression errors as-is instead of just setting the badbit
+      stream.exceptions(std::ios_base::badbit);
+    }
+    /**
+     * Creates a deserializer decompressing the blocks ahead in parallel on the given thread pool.
+     */
+    CompressedDeserializer(std::istream& is, ThreadPool& pool,
+                           std::size_t maxBlockSize = CompressingOutputStream::DEFAULT_BLOCK_SIZE)
+        : stream(is, pool, maxBlockSize), deserializer(stream) {
+      stream.exceptions(std::ios_base::badbit);
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> read(T& val) { deserializer.read(val); }
+
+    template <typename T>
+    std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues)
+      requires SkippingDeserializer<D>
+    {
+      deserializer.template skip<T>(numValues);
+    }
+
+  private:
+    DecompressingInputStream stream;
+    D deserializer;
+  };
+
+} // namespace serialize
@@ -0,0 +1,212 @@
+/*
+ * Delta serialization of objects against a previous version of the same object.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+#include "serialize.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * Concept for containers whose elements are compared and updated index by index (e.g. std::vector, std::deque or
+     * std::array). Strings and containers without addressable elements (e.g. std::vector<bool>) are always replaced as
+     * a whole.
+     */
+    template <typename T>
+    concept DeltaIndexedContainer =
+        std::ranges::random_access_range<T> && std::ranges::sized_range<T> &&
+        std::is_lvalue_reference_v<std::ranges::range_reference_t<T>> && !requires { typename T::traits_type; } &&
+        (is_fixed_size_container_v<T> || requires(T obj) { obj.resize(std::declval<std::size_t>()); });
+
+    /**
+     * Returns whether the changed container elements are written as list of indices instead of a bitmap, which is the
+     * case if only few elements changed.
+     */
+    constexpr bool useChangedIndices(std::size_t numChanged, std::size_t numElements) noexcept {
+      return numChanged * 16 < numElements;
+    }
+
+    [[noreturn]] void throwOnInvalidDelta(const char* reason);
+
+    template <typename T> bool differs(const T& previous, const T& current) {
+      if constexpr (ReflectableAggregate<T>) {
+        return [&previous, &current]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          return (differs(memberAt<Indices>(previous), memberAt<Indices>(current)) || ...);
+        }(std::make_index_sequence<memberCount<T>>{});
+      } else if constexpr (DeltaIndexedContainer<T>) {
+        if (std::ranges::size(previous) != std::ranges::size(current)) {
+          return true;
+        }
+        for (std::size_t i = 0; i < std::ranges::size(current); ++i) {
+          if (differs(previous[i], current[i])) {
+            return true;
+          }
+        }
+        return false;
+      } else if constexpr (std::equality_comparable<T>) {
+        return previous != current;
+      } else {
+        return true;
+      }
+    }
+
+    /**
+     * Writes the changes from the previous to the current value, which are known to differ.
+     */
+    template <Serializer S, typename T> void writeDelta(S& serializer, const T& previous, const T& current) {
+      if constexpr (ReflectableAggregate<T>) {
+        std::bitset<memberCount<T>> changed{};
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          (changed.set(Indices, differs(memberAt<Indices>(previous), memberAt<Indices>(current))), ...);
+          serialize(serializer, changed);
+          ((changed.test(Indices) ? writeDelta(serializer, memberAt<Indices>(previous), memberAt<Indices>(current))
+                                  : void()),
+           ...);
+        }(std::make_index_sequence<memberCount<T>>{});
+      } else if constexpr (DeltaIndexedContainer<T>) {
+        auto numElements = std::ranges::size(current);
+        auto numCommon = std::min<std::size_t>(std::ranges::size(previous), numElements);
+        std::vector<std::size_t> changedIndices{};
+        for (std::size_t i = 0; i < numCommon; ++i) {
+          if (differs(previous[i], current[i])) {
+            changedIndices.push_back(i);
+          }
+        }
+        serialize(serializer, std::size_t{numElements});
+        serialize(serializer, changedIndices.size());
+        if (useChangedIndices(changedIndices.size(), numCommon)) {
+          std::size_t next = 0;
+          for (auto index : changedIndices) {
+            serialize(serializer, index - next);
+            next = index + 1;
+          }
+        } else {
+          std::vector<uint8_t> bitmap((numCommon + 7) / 8);
+          for (auto index : changedIndices) {
+            bitmap[index / 8] = static_cast<uint8_t>(bitmap[index / 8] | (1U << (index % 8)));
+          }
+          serialize(serializer, bitmap);
+        }
+        for (auto index : changedIndices) {
+          writeDelta(serializer, previous[index], current[index]);
+        }
+        for (std::size_t i = numCommon; i < numElements; ++i) {
+          serialize(serializer, current[i]);
+        }
+      } else {
+        serialize(serializer, current);
+      }
+    }
+
+    /**
+     * Applies the changes written by writeDelta() to the given object.
+     */
+    template <Deserializer D, typename T> void readDelta(D& deserializer, T& object) {
+      if constexpr (ReflectableAggregate<T>) {
+        auto changed = deserialize<std::bitset<memberCount<T>>>(deserializer);
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          ((changed.test(Indices) ? readDelta(deserializer, memberAt<Indices>(object)) : void()), ...);
+        }(std::make_index_sequence<memberCount<T>>{});
+      } else if constexpr (DeltaIndexedContainer<T>) {
+        auto numElements = deserialize<std::size_t>(deserializer);
+        auto numCommon = std::min<std::size_t>(std::ranges::size(object), numElements);
+        auto numChanged = deserialize<std::size_t>(deserializer);
+        if (numChanged > numCommon) {
+          throwOnInvalidDelta("More changed elements than existing elements");
+        }
+        std::vector<std::size_t> changedIndices{};
+        changedIndices.reserve(numChanged);
+        if (useChangedIndices(numChanged, numCommon)) {
+          std::size_t next = 0;
+          for (std::size_t i = 0; i < numChanged; ++i) {
+            auto index = next + deserialize<std::size_t>(deserializer);
+            if (index < next || index >= numCommon) {
+              throwOnInvalidDelta("Changed element index out of bounds");
+            }
+            changedIndices.push_back(index);
+            next = index + 1;
+          }
+        } else {
+          auto bitmap = deserialize<std::vector<uint8_t>>(deserializer);
+          if (bitmap.size() != (numCommon + 7) / 8) {
+            throwOnInvalidDelta("Invalid size of changed elements bitmap");
+          }
+          for (std::size_t i = 0; i < numCommon; ++i) {
+            if (bitmap[i / 8] & (1U << (i % 8))) {
+              changedIndices.push_back(i);
+            }
+          }
+          if (changedIndices.size() != numChanged) {
+            throwOnInvalidDelta("Invalid number of changed elements");
+          }
+        }
+        if constexpr (is_fixed_size_container_v<T>) {
+          if (numElements != std::ranges::size(object)) {
+            throwOnInvalidDelta("Cannot change the size of a fixed-size container");
+          }
+        } else {
+          object.resize(numElements);
+        }
+        for (auto index : changedIndices) {
+          readDelta(deserializer, object[index]);
+        }
+        for (std::size_t i = numCommon; i < numElements; ++i) {
+          deserializeInto(deserializer, object[i]);
+        }
+      } else {
+        deserializeInto(deserializer, object);
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Serializes only the changes between the previous and the current version of an object.
+   *
+   * The objects are compared recursively: Aggregate types write a bitmap of the changed members followed by the changes
+   * of these members, index-based containers (e.g. std::vector or std::array) write their new size, the changed
+   * elements as a bitmap (or as list of indices, if only few elements changed) followed by the changes of these
+   * elements and any appended elements. All other types (e.g. strings or maps) are written completely, if changed.
+   *
+   * Returns whether any changes were written.
+   */
+  template <Serializer S, typename T> bool serializeDelta(S& serializer, const T& previous, const T& current) {
+    bool changed = detail::differs(previous, current);
+    serialize(serializer, changed);
+    if (changed) {
+      detail::writeDelta(serializer, previous, current);
+    }
+    return changed;
+  }
+
+  /**
+   * Applies the changes written by serializeDelta() to the given object, which needs to be equal to the previous
+   * version passed to serializeDelta().
+   *
+   * Returns whether the object was changed. Malformed data is reported by throwing a std::domain_error.
+   */
+  template <Deserializer D, typename T> bool applyDelta(D& deserializer, T& object) {
+    bool changed = deserialize<bool>(deserializer);
+    if (changed) {
+      detail::readDelta(deserializer, object);
+    }
+    return changed;
+  }
+
+} // namespace serialize
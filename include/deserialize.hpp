@@ -9,22 +9,28 @@
 
 #include "common.hpp"
 
+#include <algorithm>
 #include <any>
 #include <array>
 #include <atomic>
 #include <bitset>
 #include <chrono>
 #include <complex>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace serialize {
 
@@ -56,17 +62,49 @@ namespace serialize {
     obj.read(std::declval<char8_t&>());
   };
 
+  /**
+   * Extension of the Deserializer reading the native representation of fundamental values and allowing to read the
+   * concatenated native representation of multiple values at once.
+   */
+  template <typename T>
+  concept NativeBlockDeserializer =
+      Deserializer<T> && requires(T obj) { obj.readNative(std::declval<std::span<std::byte>>()); };
+
+  /**
+   * Extension of the Deserializer reading strings itself instead of as container of characters.
+   */
+  template <typename T>
+  concept StringDeserializer = Deserializer<T> && requires(T obj) {
+    /**
+     * Prototype for a function reading the next string and returning a view into storage owned by the deserializer,
+     * which stays valid at least until the next string is read.
+     */
+    { obj.readString() } -> std::same_as<std::string_view>;
+  };
+
+  /**
+   * Extension of the Deserializer reading shared objects itself, e.g. to restore the sharing of objects referenced
+   * multiple times.
+   */
+  template <typename T>
+  concept SharingDeserializer = Deserializer<T> && requires(T obj) {
+    /**
+     * Prototype for a function reading the next (possibly back-referenced) shared object of the template type.
+     */
+    { obj.template readShared<int>() } -> std::same_as<std::shared_ptr<int>>;
+  };
+
   /**
    * Helper function to deserialize into an existing object.
    */
-  template <typename T, Deserializer D> void deserializeInto(D& deserializer, T& out);
+  template <typename T, Deserializer D> constexpr void deserializeInto(D& deserializer, T& out);
 
   namespace detail {
     /**
      * Helper type for basic deserialization, directly calling the corresponding Deserializer member function.
      */
     template <typename T> struct BasicDeserializerCall {
-      template <Deserializer D> T operator()(D& deserializer) const {
+      template <Deserializer D> constexpr T operator()(D& deserializer) const {
         std::remove_const_t<T> tmp{};
         deserializer.read(tmp);
         return tmp;
@@ -80,6 +118,18 @@ namespace serialize {
       template <Deserializer D> void operator()(D& deserializer) const = delete;
     };
 
+    /**
+     * Helper type for deserializing shared objects, which is disabled for all deserializers not reading the shared
+     * objects themselves.
+     */
+    template <typename T, typename Ptr> struct SharedDeserializerCall : DisabledDeserializerCall {
+      using DisabledDeserializerCall::operator();
+
+      template <SharingDeserializer D> Ptr operator()(D& deserializer) const {
+        return Ptr{deserializer.template readShared<T>()};
+      }
+    };
+
     [[noreturn]] inline void throwOnEof() { throw std::out_of_range{"Unexpected EOF while deserializing data"}; }
   } // namespace detail
 
@@ -100,8 +150,12 @@ namespace serialize {
   template <typename T> static constexpr detail::DisabledDeserializerCall deserialize<T*>;
   template <typename T> static constexpr detail::DisabledDeserializerCall deserialize<T&>;
   template <typename T> static constexpr detail::DisabledDeserializerCall deserialize<std::span<T>>;
-  template <typename T> static constexpr detail::DisabledDeserializerCall deserialize<std::shared_ptr<T>>;
-  template <> inline constexpr detail::DisabledDeserializerCall deserialize<std::string_view>;
+  /**
+   * Strings can only be deserialized as views into the storage of deserializers reading the strings themselves.
+   */
+  template <>
+  inline constexpr auto deserialize<std::string_view> =
+      [](StringDeserializer auto& deserializer) -> std::string_view { return deserializer.readString(); };
   // There is no guaranteed way to map the stored type to some serializable value and back
   template <> inline constexpr detail::DisabledDeserializerCall deserialize<std::any>;
   // Cannot return a copy of a deserialized C array
@@ -158,26 +212,95 @@ namespace serialize {
           // e.g. std::vector, std::list
           requires(T obj) { obj.push_back(std::declval<std::ranges::range_value_t<T>>()); });
 
+  namespace detail {
+    template <DeserializableGrowableContainer C, Deserializer D>
+    constexpr C deserializeGrowableContainer(D& deserializer) {
+      using ValueType = std::ranges::range_value_t<C>;
+      using SizeType = decltype(std::ranges::size(std::declval<C>()));
+      C result{};
+      auto resultSize = deserialize<SizeType>(deserializer);
+      if constexpr (requires(C obj) { obj.reserve(std::declval<SizeType>()); }) {
+        result.reserve(resultSize);
+      }
+      for (SizeType i = 0; i < resultSize; ++i) {
+        if constexpr (requires(C obj) { obj.emplace(std::declval<ValueType>()); }) {
+          result.emplace(deserialize<ValueType>(deserializer));
+        } else {
+          result.push_back(deserialize<ValueType>(deserializer));
+        }
+      }
+      return result;
+    }
+  } // namespace detail
+
   /**
    * Deserialize any growable container (e.g. std::map, std::set std::string, std::unordered_set, std::vector,
    * std::list)
    */
   template <DeserializableGrowableContainer C>
   static constexpr auto deserialize<C> = [](Deserializer auto& deserializer) {
-    using ValueType = std::ranges::range_value_t<C>;
-    using SizeType = decltype(std::ranges::size(std::declval<C>()));
-    C result{};
-    auto resultSize = deserialize<SizeType>(deserializer);
-    if constexpr (requires(C obj) { obj.reserve(std::declval<SizeType>()); }) {
-      result.reserve(resultSize);
+    return detail::deserializeGrowableContainer<C>(deserializer);
+  };
+
+  /**
+   * Deserialize a std::string, letting deserializers reading the strings themselves do so.
+   */
+  template <>
+  inline constexpr auto deserialize<std::string> = [](Deserializer auto& deserializer) {
+    if constexpr (StringDeserializer<std::remove_reference_t<decltype(deserializer)>>) {
+      return std::string{deserializer.readString()};
+    } else {
+      return detail::deserializeGrowableContainer<std::string>(deserializer);
     }
-    for (SizeType i = 0; i < resultSize; ++i) {
-      if constexpr (requires(C obj) { obj.emplace(std::declval<ValueType>()); }) {
-        result.emplace(deserialize<ValueType>(deserializer));
+  };
+  // e.g. keys of std::map
+  template <> inline constexpr auto deserialize<const std::string> = deserialize<std::string>;
+
+  namespace detail {
+    /**
+     * Reads the given number of packed bits (or other bytes) written by writePackedBytes().
+     */
+    template <Deserializer D> constexpr void readPackedBytes(D& deserializer, std::span<std::byte> bytes) {
+      if constexpr (NativeBlockDeserializer<D>) {
+        deserializer.readNative(bytes);
       } else {
-        result.push_back(deserialize<ValueType>(deserializer));
+        for (auto& byte : bytes) {
+          byte = std::bit_cast<std::byte>(deserialize<uint8_t>(deserializer));
+        }
       }
     }
+
+    /**
+     * Unpacks the given number of bits written by packBits() by reading 64-bit words and writing the bits one by one
+     * to the iterator.
+     */
+    template <typename Iterator> constexpr void unpackBits(const std::byte* in, std::size_t numBits, Iterator bits) {
+      for (std::size_t offset = 0; offset < numBits; offset += 64) {
+        auto wordBits = std::min<std::size_t>(numBits - offset, 64);
+        uint64_t word = 0;
+        for (std::size_t i = 0; i < (wordBits + 7) / 8; ++i) {
+          word |= std::to_integer<uint64_t>(*in++) << (8 * i);
+        }
+        for (std::size_t i = 0; i < wordBits; ++i, ++bits) {
+          *bits = (word >> i) & 1U;
+        }
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Deserialize a std::vector<bool> written as its size followed by the packed bits.
+   */
+  template <typename Alloc>
+  static constexpr auto deserialize<std::vector<bool, Alloc>> = [](Deserializer auto& deserializer) {
+    std::vector<bool, Alloc> result(deserialize<std::size_t>(deserializer));
+    std::array<std::byte, detail::PACKED_BITS_CHUNK_SIZE> chunk;
+    for (std::size_t offset = 0; offset < result.size(); offset += chunk.size() * 8) {
+      auto numBits = std::min(result.size() - offset, chunk.size() * 8);
+      auto bytes = std::span{chunk}.first((numBits + 7) / 8);
+      detail::readPackedBytes(deserializer, bytes);
+      detail::unpackBits(bytes.data(), numBits, result.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
     return result;
   };
 
@@ -202,6 +325,15 @@ namespace serialize {
     return std::make_pair(std::move(first), std::move(second));
   };
 
+  /**
+   * Shared objects can only be deserialized by deserializers reading the shared objects themselves, e.g. to restore
+   * the sharing of the objects.
+   */
+  template <typename T>
+  static constexpr detail::SharedDeserializerCall<T, std::shared_ptr<T>> deserialize<std::shared_ptr<T>>;
+  template <typename T>
+  static constexpr detail::SharedDeserializerCall<T, std::weak_ptr<T>> deserialize<std::weak_ptr<T>>;
+
   template <typename T>
   static constexpr auto deserialize<std::unique_ptr<T>> = [](Deserializer auto& deserializer) {
     if (deserialize<bool>(deserializer)) {
@@ -240,6 +372,16 @@ namespace serialize {
     if constexpr (!std::is_same_v<detail::EnclosingUnsignedType<N>, void>) {
       // can read as integral
       return std::bitset<N>{deserialize<detail::EnclosingUnsignedType<N>>(deserializer)};
+    } else if constexpr (detail::hasPackedBitsetLayout<N>()) {
+      // read the chunks of bits directly into the object representation
+      std::bitset<N> result{};
+      std::span bytes{reinterpret_cast<std::byte*>(&result), (N + 7) / 8};
+      detail::readPackedBytes(deserializer, bytes);
+      if constexpr (N % 8) {
+        // the unused bits need to stay cleared
+        bytes.back() &= std::byte{(1U << (N % 8)) - 1U};
+      }
+      return result;
     } else {
       // need to read as chunks of bits
       std::bitset<N> result{};
@@ -340,7 +482,7 @@ namespace serialize {
     return tmp;
   };
 
-  template <typename T, Deserializer D> void deserializeInto(D& deserializer, T& out) {
+  template <typename T, Deserializer D> constexpr void deserializeInto(D& deserializer, T& out) {
     out = deserialize<T>(deserializer);
   }
 } // namespace serialize
@@ -0,0 +1,166 @@
+/*
+ * Constexpr-capable Serializer and Deserializer for fixed-size byte arrays.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace serialize {
+
+  namespace detail {
+    [[noreturn]] void throwOnBufferOverflow(std::size_t capacity);
+  } // namespace detail
+
+  /**
+   * Serializer only counting the number of bytes written by the FixedBufferSerializer, e.g. to determine the size of
+   * the buffer required to serialize a value at compile time.
+   */
+  class SizeCountingSerializer {
+  public:
+    template <typename T> constexpr std::enable_if_t<std::is_fundamental_v<T>> write(T /* val */) noexcept {
+      numBytes += sizeof(T);
+    }
+
+    constexpr void flush() noexcept {}
+
+    constexpr std::size_t size() const noexcept { return numBytes; }
+
+  private:
+    std::size_t numBytes = 0;
+  };
+
+  /**
+   * Serializer writing into a fixed-size byte array, usable in constant expressions.
+   *
+   * Values are written in their native representation like the SimpleStreamSerializer does for the same platform, i.e.
+   * the output can also be read with the SimpleStreamDeserializer. Writing more data than fits into the buffer throws a
+   * std::out_of_range error (resp. fails to compile in a constant expression).
+   */
+  template <std::size_t N> class FixedBufferSerializer {
+  public:
+    template <typename T> constexpr std::enable_if_t<std::is_fundamental_v<T>> write(T val) {
+      if (sizeof(T) > N - position) {
+        detail::throwOnBufferOverflow(N);
+      }
+      auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(val);
+      std::copy(bytes.begin(), bytes.end(), buffer.begin() + position);
+      position += sizeof(T);
+    }
+
+    /**
+     * Writes the given bytes as-is, e.g. the concatenated native representation of multiple values.
+     */
+    constexpr void writeNative(std::span<const std::byte> data) {
+      if (data.size() > N - position) {
+        detail::throwOnBufferOverflow(N);
+      }
+      std::copy(data.begin(), data.end(), buffer.begin() + position);
+      position += data.size();
+    }
+
+    constexpr void flush() noexcept {}
+
+    /**
+     * Returns the whole buffer, including any trailing unused bytes.
+     */
+    constexpr const std::array<std::byte, N>& data() const noexcept { return buffer; }
+
+    /**
+     * Returns the number of bytes written so far.
+     */
+    constexpr std::size_t size() const noexcept { return position; }
+
+  private:
+    std::array<std::byte, N> buffer{};
+    std::size_t position = 0;
+  };
+
+  /**
+   * Deserializer reading the data written by the FixedBufferSerializer (or SimpleStreamSerializer) from a non-owning
+   * byte range, usable in constant expressions.
+   */
+  class FixedBufferDeserializer {
+  public:
+    constexpr explicit FixedBufferDeserializer(std::span<const std::byte> data) noexcept : data(data) {}
+
+    template <typename T> constexpr std::enable_if_t<std::is_fundamental_v<T>> read(T& val) {
+      if (data.size() < sizeof(T)) {
+        detail::throwOnEof();
+      }
+      std::array<std::byte, sizeof(T)> bytes{};
+      std::copy_n(data.begin(), sizeof(T), bytes.begin());
+      val = std::bit_cast<T>(bytes);
+      data = data.subspan(sizeof(T));
+    }
+
+    template <typename T> constexpr std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues) {
+      if (data.size() / sizeof(T) < numValues) {
+        detail::throwOnEof();
+      }
+      data = data.subspan(numValues * sizeof(T));
+    }
+
+    /**
+     * Reads the native representation of multiple values into the given bytes as-is.
+     */
+    constexpr void readNative(std::span<std::byte> out) {
+      if (data.size() < out.size()) {
+        detail::throwOnEof();
+      }
+      std::copy_n(data.begin(), out.size(), out.begin());
+      data = data.subspan(out.size());
+    }
+
+    /**
+     * Returns the number of bytes not yet read.
+     */
+    constexpr std::size_t remaining() const noexcept { return data.size(); }
+
+  private:
+    std::span<const std::byte> data;
+  };
+
+  /**
+   * Returns the number of bytes required to serialize the given value with the FixedBufferSerializer.
+   */
+  template <typename T> constexpr std::size_t serializedSize(const T& value) {
+    SizeCountingSerializer serializer{};
+    serialize(serializer, value);
+    return serializer.size();
+  }
+
+  /**
+   * Serializes the given value into a byte array of the given size, which can be calculated via serializedSize():
+   *
+   *     constexpr auto TABLE = serializeToArray<serializedSize(createTable())>(createTable());
+   *
+   * Evaluated in a constant expression, the array can be embedded into the binary as-is. Any trailing bytes not
+   * required for the value are zero.
+   */
+  template <std::size_t N, typename T> constexpr std::array<std::byte, N> serializeToArray(const T& value) {
+    FixedBufferSerializer<N> serializer{};
+    serialize(serializer, value);
+    return serializer.data();
+  }
+
+  /**
+   * Deserializes a value of the given type from the given bytes, e.g. written by serializeToArray().
+   */
+  template <typename T> constexpr T deserializeFromBuffer(std::span<const std::byte> data) {
+    FixedBufferDeserializer deserializer{data};
+    return deserialize<T>(deserializer);
+  }
+
+} // namespace serialize
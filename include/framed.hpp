@@ -0,0 +1,184 @@
+/*
+ * Length-framed record streams wrapping other (de-)serializers.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "streams.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * The default maximum size in bytes of a single record accepted by the FramedStreamReader and TaggedRecordReader.
+   */
+  constexpr std::size_t DEFAULT_MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+  namespace detail {
+    /**
+     * Writes the frame header (the payload size in bytes) followed by the payload.
+     */
+    void writeFrame(std::ostream& out, std::span<const std::byte> payload);
+
+    /**
+     * Reads the next frame header, returns an empty value if the stream ends before the frame.
+     */
+    std::optional<std::size_t> readFrameSize(std::istream& in);
+
+    /**
+     * Reads the payload of the frame with the given size into the buffer, reusing its memory. Frames larger than the
+     * given maximum size are rejected before allocating any memory.
+     */
+    void readFramePayload(std::istream& in, std::size_t size, std::size_t maxSize, std::vector<std::byte>& buffer);
+
+    /**
+     * Moves past the payload of the frame with the given size.
+     */
+    void skipFramePayload(std::istream& in, std::size_t size);
+  } // namespace detail
+
+  /**
+   * Writer prefixing each top-level object with its serialized size in bytes.
+   *
+   * Each record is serialized with the wrapped Serializer type into an internal buffer (reused across records) and then
+   * written as a single frame to the output stream. The wrapped serializer is flushed after each record, i.e. every
+   * record starts at a byte boundary.
+   */
+  template <Serializer S>
+    requires(std::constructible_from<S, std::ostream&>)
+  class FramedStreamWriter {
+  public:
+    explicit FramedStreamWriter(std::ostream& os) : out(os), serializer(buffer) {}
+
+    template <typename T> void write(const T& record) {
+      buffer.reset();
+      serialize::serialize(serializer, record);
+      serializer.flush();
+      detail::writeFrame(out, buffer.data());
+    }
+
+    void flush() { out.flush(); }
+
+  private:
+    std::ostream& out;
+    BufferOutputStream buffer;
+    S serializer;
+  };
+
+  /**
+   * Reader exposing the records written by the FramedStreamWriter as lazily deserialized input range.
+   *
+   * Only a single record is kept in memory at any time and whole records can be skipped via #skip() without decoding
+   * them. Deserialization of each record is done with a new instance of the wrapped Deserializer type, so errors in
+   * a single record do not propagate to following records.
+   *
+   * Records larger than the given maximum frame size (i.e. corrupted frame headers) are reported by throwing a
+   * std::domain_error. The maximum frame size needs to be at least the serialized size of the largest record.
+   */
+  template <typename T, Deserializer D>
+    requires(std::constructible_from<D, std::istream&>)
+  class FramedStreamReader {
+  public:
+    class iterator {
+    public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() noexcept = default;
+      explicit iterator(FramedStreamReader* reader) noexcept : reader(reader) {}
+
+      const T& operator*() const { return *reader->current; }
+      const T* operator->() const { return &*reader->current; }
+
+      iterator& operator++() {
+        reader->advance();
+        return *this;
+      }
+
+      void operator++(int) { ++*this; }
+
+      friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it.atEnd(); }
+
+    private:
+      bool atEnd() const noexcept { return !reader || !reader->current; }
+
+      FramedStreamReader* reader = nullptr;
+    };
+
+    explicit FramedStreamReader(std::istream& is, std::size_t maxFrameSize = DEFAULT_MAX_FRAME_SIZE)
+        : in(is), maxFrameSize(maxFrameSize), payloadStream(std::span<const std::byte>{}) {}
+
+    // iterators refer to the reader object
+    FramedStreamReader(const FramedStreamReader&) = delete;
+    FramedStreamReader& operator=(const FramedStreamReader&) = delete;
+
+    /**
+     * Returns an iterator to the current record, reading the first record if necessary.
+     */
+    iterator begin() {
+      if (!started) {
+        advance();
+      }
+      return iterator{this};
+    }
+
+    std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    /**
+     * Skips the given number of records without deserializing them, returns the number of records actually skipped.
+     *
+     * If iteration has already been started, the current record counts as first skipped record.
+     */
+    std::size_t skip(std::size_t numRecords = 1) {
+      if (!numRecords || (started && !current)) {
+        return 0;
+      }
+      std::size_t numSkipped = started ? 1 : 0;
+      for (; numSkipped < numRecords; ++numSkipped) {
+        auto size = detail::readFrameSize(in);
+        if (!size) {
+          break;
+        }
+        detail::skipFramePayload(in, *size);
+      }
+      if (started) {
+        advance();
+      }
+      return numSkipped;
+    }
+
+  private:
+    void advance() {
+      started = true;
+      current.reset();
+      if (auto size = detail::readFrameSize(in)) {
+        detail::readFramePayload(in, *size, maxFrameSize, payload);
+        payloadStream.reset(payload);
+        D deserializer{payloadStream};
+        current.emplace(deserialize<T>(deserializer));
+      }
+    }
+
+    std::istream& in;
+    std::size_t maxFrameSize;
+    std::vector<std::byte> payload;
+    SpanInputStream payloadStream;
+    std::optional<T> current;
+    bool started = false;
+  };
+
+} // namespace serialize
@@ -0,0 +1,220 @@
+/*
+ * Object graph serialization wrappers, preserving the identity of shared objects.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "skip.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * The shared pointer is empty (or the weak pointer expired), no object follows.
+     */
+    static constexpr std::size_t SHARED_NULL = 0;
+    /**
+     * The object follows inline and is assigned the next object ID.
+     */
+    static constexpr std::size_t SHARED_NEW = 1;
+    /**
+     * Any larger value references the object with the ID of the value minus this offset.
+     */
+    static constexpr std::size_t SHARED_REFERENCE_OFFSET = 2;
+
+    struct SharedObjectKey {
+      const void* address;
+      std::type_index type;
+
+      bool operator==(const SharedObjectKey& other) const noexcept = default;
+    };
+
+    struct SharedObjectKeyHash {
+      std::size_t operator()(const SharedObjectKey& key) const noexcept {
+        return std::hash<const void*>{}(key.address) ^ (key.type.hash_code() << 1);
+      }
+    };
+
+    [[noreturn]] void throwOnInvalidSharedReference(std::size_t index, std::size_t numObjects);
+    [[noreturn]] void throwOnSharedTypeMismatch(const std::type_info& expectedType, const std::type_info& actualType);
+    [[noreturn]] void throwOnIncompleteSharedObject(const std::type_info& type);
+  } // namespace detail
+
+  /**
+   * Wrapper around any other Serializer writing every object referenced by std::shared_ptr and std::weak_ptr only once.
+   *
+   * Every object is assigned an ID on its first occurrence and written as-is, any further occurrence (also from within
+   * the object itself) is written as the object ID only. Objects are identified by their address and static type, so
+   * objects referenced via pointers to different (e.g. base) types are written separately.
+   *
+   * The serializer keeps all written objects alive to guarantee that their addresses are not reused for other objects.
+   */
+  template <Serializer Inner> class ObjectGraphSerializer {
+  public:
+    explicit ObjectGraphSerializer(Inner& inner) : inner(inner) {}
+
+    explicit ObjectGraphSerializer(Inner&& inner)
+        : innerHolder(std::make_unique<Inner>(std::move(inner))), inner(*innerHolder) {}
+
+    explicit ObjectGraphSerializer(std::unique_ptr<Inner>&& inner)
+        : innerHolder(std::move(inner)), inner(*innerHolder) {
+      if (!innerHolder)
+        throw std::invalid_argument{"Cannot wrap a NULL serializer object"};
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) { inner.write(val); }
+
+    void write(std::size_t numElements, std::span<const std::byte> data)
+      requires ByteSerializer<Inner>
+    {
+      inner.write(numElements, data);
+    }
+
+    /**
+     * Writes the object referenced by the given pointer, either as reference to an earlier occurrence or as-is.
+     */
+    template <typename T> void writeShared(const std::shared_ptr<T>& object) {
+      if (!object) {
+        serialize(inner, detail::SHARED_NULL);
+        return;
+      }
+      detail::SharedObjectKey key{object.get(), typeid(std::remove_cv_t<T>)};
+      if (auto it = objectIds.find(key); it != objectIds.end()) {
+        serialize(inner, it->second + detail::SHARED_REFERENCE_OFFSET);
+        return;
+      }
+      // register before writing the contents to resolve cyclic references
+      objectIds.emplace(key, objects.size());
+      objects.emplace_back(object);
+      serialize(inner, detail::SHARED_NEW);
+      serialize(*this, *object);
+    }
+
+    /**
+     * Returns the number of distinct objects written.
+     */
+    std::size_t numObjects() const noexcept { return objects.size(); }
+
+    void flush() { inner.flush(); }
+
+  private:
+    std::unique_ptr<Inner> innerHolder;
+    Inner& inner;
+    std::vector<std::shared_ptr<const void>> objects;
+    std::unordered_map<detail::SharedObjectKey, std::size_t, detail::SharedObjectKeyHash> objectIds;
+  };
+
+  /**
+   * Wrapper around any other Deserializer reading the object graphs written by an ObjectGraphSerializer.
+   *
+   * Every object is only created once and all references to it are restored as pointers to the same object. For
+   * default-constructible types, the object is created before its contents are read, allowing for cyclic references.
+   * Cyclic references to other objects are reported by throwing a std::domain_error, as are invalid references and
+   * references to objects of a different type.
+   *
+   * The deserializer keeps all read objects alive, so objects only referenced via std::weak_ptr stay valid for the
+   * lifetime of this deserializer.
+   *
+   * This deserializer is a SharingDeserializer, i.e. it reads all std::shared_ptr and std::weak_ptr objects (also as
+   * part of containers or aggregates) itself. Skipped shared objects are still registered to keep the references of
+   * following objects valid.
+   */
+  template <Deserializer Inner> class ObjectGraphDeserializer {
+  public:
+    explicit ObjectGraphDeserializer(Inner& inner) : inner(inner) {}
+
+    explicit ObjectGraphDeserializer(Inner&& inner)
+        : innerHolder(std::make_unique<Inner>(std::move(inner))), inner(*innerHolder) {}
+
+    explicit ObjectGraphDeserializer(std::unique_ptr<Inner>&& inner)
+        : innerHolder(std::move(inner)), inner(*innerHolder) {
+      if (!innerHolder)
+        throw std::invalid_argument{"Cannot wrap a NULL deserializer object"};
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> read(T& val) { inner.read(val); }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues) {
+      detail::skipValues<T>(inner, numValues);
+    }
+
+    /**
+     * Reads the next shared object, resolving references to earlier occurrences.
+     */
+    template <typename T> std::shared_ptr<T> readShared() {
+      using Type = std::remove_cv_t<T>;
+      auto marker = deserialize<std::size_t>(inner);
+      if (marker == detail::SHARED_NULL) {
+        return nullptr;
+      }
+      if (marker >= detail::SHARED_REFERENCE_OFFSET) {
+        auto index = marker - detail::SHARED_REFERENCE_OFFSET;
+        if (index >= objects.size()) {
+          detail::throwOnInvalidSharedReference(index, objects.size());
+        }
+        const auto& entry = objects[index];
+        if (*entry.type != typeid(Type)) {
+          detail::throwOnSharedTypeMismatch(typeid(Type), *entry.type);
+        }
+        if (!entry.object) {
+          detail::throwOnIncompleteSharedObject(typeid(Type));
+        }
+        return std::static_pointer_cast<Type>(entry.object);
+      }
+      if constexpr (std::is_default_constructible_v<Type>) {
+        // register before reading the contents to resolve cyclic references
+        auto object = std::make_shared<Type>();
+        objects.push_back(Entry{object, &typeid(Type)});
+        deserializeInto(*this, *object);
+        return object;
+      } else {
+        auto index = objects.size();
+        objects.push_back(Entry{nullptr, &typeid(Type)});
+        auto object = std::make_shared<Type>(deserialize<Type>(*this));
+        objects[index].object = object;
+        return object;
+      }
+    }
+
+    /**
+     * Returns the number of distinct objects read.
+     */
+    std::size_t numObjects() const noexcept { return objects.size(); }
+
+  private:
+    struct Entry {
+      std::shared_ptr<void> object;
+      const std::type_info* type;
+    };
+
+    std::unique_ptr<Inner> innerHolder;
+    Inner& inner;
+    std::vector<Entry> objects;
+  };
+
+  template <Serializer Inner, typename T>
+  void serialize(ObjectGraphSerializer<Inner>& serializer, const std::shared_ptr<T>& object) {
+    serializer.writeShared(object);
+  }
+
+  template <Serializer Inner, typename T>
+  void serialize(ObjectGraphSerializer<Inner>& serializer, const std::weak_ptr<T>& object) {
+    serializer.writeShared(object.lock());
+  }
+
+} // namespace serialize
@@ -0,0 +1,320 @@
+/*
+ * Random-access Serializer and Deserializer using a table-of-offsets layout for lazy member access.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+#include "serialize.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * Offset of a member/element relative to the start of the enclosing aggregate/container.
+     */
+    using IndexedOffset = uint32_t;
+
+    /**
+     * Number of elements in an indexed container.
+     */
+    using IndexedSize = uint64_t;
+
+    /**
+     * Serializer appending the native representation of all fundamental values to a byte buffer, used for all values
+     * which are not laid out with a table-of-offsets.
+     */
+    class IndexedLeafSerializer {
+    public:
+      explicit IndexedLeafSerializer(std::vector<std::byte>& buffer) : buffer(buffer) {}
+
+      template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) {
+        append(std::as_bytes(std::span<const T, 1>{&val, 1}));
+      }
+
+      void write(std::size_t numElements, std::span<const std::byte> data) {
+        write(numElements);
+        append(data);
+      }
+
+      void flush() {}
+
+    private:
+      void append(std::span<const std::byte> data) { buffer.insert(buffer.end(), data.begin(), data.end()); }
+
+      std::vector<std::byte>& buffer;
+    };
+
+    /**
+     * Deserializer reading values written by the IndexedLeafSerializer.
+     */
+    class IndexedLeafDeserializer {
+    public:
+      explicit IndexedLeafDeserializer(std::span<const std::byte> data) : data(data) {}
+
+      template <typename T> std::enable_if_t<std::is_fundamental_v<T>> read(T& val) {
+        if (data.size() < sizeof(T)) {
+          detail::throwOnEof();
+        }
+        std::memcpy(&val, data.data(), sizeof(T));
+        data = data.subspan(sizeof(T));
+      }
+
+    private:
+      std::span<const std::byte> data;
+    };
+
+    template <typename T> struct is_std_array : std::false_type {};
+    template <typename T, std::size_t N> struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    /**
+     * Containers are laid out as element count followed by either the raw elements (for fundamental element types) or
+     * a table of offsets to the elements.
+     */
+    template <typename T>
+    constexpr bool is_indexed_container_v = !std::is_fundamental_v<T> &&
+                                            (SerializableContainer<T> || SerializableRawData<T>) &&
+                                            (DeserializableGrowableContainer<T> || is_std_array<T>::value);
+
+    /**
+     * Aggregates are laid out as table of offsets to the members followed by the members.
+     */
+    template <typename T>
+    constexpr bool is_indexed_aggregate_v = !is_indexed_container_v<T> && StructuredBindingDeserializable<T> &&
+                                            is_structured_bindings_serializable<IndexedLeafSerializer, T>;
+
+    template <typename T>
+    constexpr bool is_indexed_fixed_element_v = std::is_fundamental_v<T> || std::is_same_v<T, std::byte>;
+
+    template <typename T> void storeIndexed(std::vector<std::byte>& buffer, std::size_t position, T value) {
+      std::memcpy(buffer.data() + position, &value, sizeof(T));
+    }
+
+    template <typename T> T loadIndexed(std::span<const std::byte> data, std::size_t position) {
+      if (position > data.size() || data.size() - position < sizeof(T)) {
+        throwOnEof();
+      }
+      T value{};
+      std::memcpy(&value, data.data() + position, sizeof(T));
+      return value;
+    }
+
+    IndexedOffset toIndexedOffset(std::size_t offset);
+    std::span<const std::byte> indexedSubspan(std::span<const std::byte> data, std::size_t offset);
+
+    template <typename T> void writeIndexed(std::vector<std::byte>& buffer, const T& value) {
+      const auto start = buffer.size();
+      if constexpr (is_indexed_container_v<T>) {
+        using ElementType = std::remove_cv_t<std::ranges::range_value_t<T>>;
+        const auto numElements = std::ranges::size(value);
+        buffer.resize(start + sizeof(IndexedSize));
+        storeIndexed(buffer, start, static_cast<IndexedSize>(numElements));
+        if constexpr (is_indexed_fixed_element_v<ElementType> && std::ranges::contiguous_range<T>) {
+          auto data = std::as_bytes(std::span<const ElementType>{std::ranges::data(value), numElements});
+          buffer.insert(buffer.end(), data.begin(), data.end());
+        } else if constexpr (is_indexed_fixed_element_v<ElementType>) {
+          IndexedLeafSerializer leaf{buffer};
+          for (const auto& element : value) {
+            serialize(leaf, element);
+          }
+        } else {
+          const auto table = buffer.size();
+          buffer.resize(table + numElements * sizeof(IndexedOffset));
+          std::size_t index = 0;
+          for (const auto& element : value) {
+            storeIndexed(buffer, table + index * sizeof(IndexedOffset), toIndexedOffset(buffer.size() - start));
+            writeIndexed(buffer, element);
+            ++index;
+          }
+        }
+      } else if constexpr (is_indexed_aggregate_v<T>) {
+        buffer.resize(start + memberCount<T> * sizeof(IndexedOffset));
+        std::size_t index = 0;
+        forEachMember(value, [&buffer, start, &index](const auto& member) {
+          storeIndexed(buffer, start + index * sizeof(IndexedOffset), toIndexedOffset(buffer.size() - start));
+          writeIndexed(buffer, member);
+          ++index;
+        });
+      } else {
+        IndexedLeafSerializer leaf{buffer};
+        serialize(leaf, value);
+      }
+    }
+
+    template <typename T> std::span<const std::byte> indexedElement(std::span<const std::byte> data, std::size_t index) {
+      using ElementType = std::remove_cv_t<std::ranges::range_value_t<T>>;
+      if (index >= loadIndexed<IndexedSize>(data, 0)) {
+        throw std::out_of_range{"Container index out of bounds"};
+      }
+      if constexpr (is_indexed_fixed_element_v<ElementType>) {
+        return indexedSubspan(data, sizeof(IndexedSize) + index * sizeof(ElementType));
+      } else {
+        auto offset = loadIndexed<IndexedOffset>(data, sizeof(IndexedSize) + index * sizeof(IndexedOffset));
+        return indexedSubspan(data, offset);
+      }
+    }
+
+    inline std::span<const std::byte> indexedMember(std::span<const std::byte> data, std::size_t index) {
+      return indexedSubspan(data, loadIndexed<IndexedOffset>(data, index * sizeof(IndexedOffset)));
+    }
+
+    template <typename T> T readIndexed(std::span<const std::byte> data) {
+      if constexpr (is_indexed_container_v<T>) {
+        using ElementType = std::remove_cv_t<std::ranges::range_value_t<T>>;
+        const auto numElements = loadIndexed<IndexedSize>(data, 0);
+        T result{};
+        if constexpr (requires(T obj) { obj.reserve(std::declval<std::size_t>()); }) {
+          result.reserve(static_cast<std::size_t>(numElements));
+        }
+        for (std::size_t i = 0; i < numElements; ++i) {
+          auto element = readIndexed<ElementType>(indexedElement<T>(data, i));
+          if constexpr (is_std_array<T>::value) {
+            result.at(i) = std::move(element);
+          } else if constexpr (requires(T obj) { obj.emplace(std::declval<ElementType>()); }) {
+            result.emplace(std::move(element));
+          } else {
+            result.push_back(std::move(element));
+          }
+        }
+        return result;
+      } else if constexpr (is_indexed_aggregate_v<T>) {
+        std::remove_cv_t<T> result{};
+        std::size_t index = 0;
+        forEachMember(result, [&data, &index](auto& member) {
+          member = readIndexed<std::remove_cvref_t<decltype(member)>>(indexedMember(data, index));
+          ++index;
+        });
+        return result;
+      } else {
+        IndexedLeafDeserializer leaf{data};
+        return deserialize<T>(leaf);
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Lazy accessor for a value serialized by the IndexedSerializer.
+   *
+   * Only the parts of the value which are actually accessed are decoded, i.e. accessing a single member of an aggregate
+   * or a single element of a container does not decode any other members or elements.
+   */
+  template <typename T> class IndexedView {
+  public:
+    explicit IndexedView(std::span<const std::byte> data) : data(data) {}
+
+    /**
+     * Decodes the whole value.
+     */
+    T get() const { return detail::readIndexed<T>(data); }
+
+    /**
+     * Returns a view of the member with the given index of an aggregate value.
+     */
+    template <std::size_t Index>
+      requires(detail::is_indexed_aggregate_v<T>)
+    auto member() const {
+      static_assert(Index < detail::memberCount<T>, "Member index out of bounds");
+      using MemberType = std::tuple_element_t<Index, detail::MemberTypes<T>>;
+      return IndexedView<MemberType>{detail::indexedMember(data, Index)};
+    }
+
+    /**
+     * Decodes only the member with the given index of an aggregate value.
+     */
+    template <std::size_t Index>
+      requires(detail::is_indexed_aggregate_v<T>)
+    auto get() const {
+      return member<Index>().get();
+    }
+
+    /**
+     * Returns the number of elements of a container value.
+     */
+    std::size_t size() const
+      requires(detail::is_indexed_container_v<T>)
+    {
+      return static_cast<std::size_t>(detail::loadIndexed<detail::IndexedSize>(data, 0));
+    }
+
+    /**
+     * Returns a view of the element with the given index of a container value.
+     */
+    auto operator[](std::size_t index) const
+      requires(detail::is_indexed_container_v<T>)
+    {
+      return IndexedView<std::remove_cv_t<std::ranges::range_value_t<T>>>{detail::indexedElement<T>(data, index)};
+    }
+
+  private:
+    std::span<const std::byte> data;
+  };
+
+  /**
+   * Serializer writing values with a table-of-offsets layout for aggregates and containers to a std::ostream.
+   *
+   * Every value passed to #serialize() is written as a separate record prefixed by its size in bytes. In contrast to
+   * the other serializers, this serializer does not model the Serializer concept, since it requires knowledge of the
+   * whole value to write the offset tables.
+   *
+   * NOTE: The offsets within a single record are limited to 32-bit values.
+   */
+  class IndexedSerializer {
+  public:
+    explicit IndexedSerializer(std::ostream& os) : out(os) {}
+
+    template <typename T> friend void serialize(IndexedSerializer& serializer, const T& object);
+
+    void flush() {}
+
+  private:
+    void writeRecord();
+
+    std::ostream& out;
+    std::vector<std::byte> buffer;
+  };
+
+  /**
+   * Serialize the given value as a single record with table-of-offsets layout.
+   */
+  template <typename T> void serialize(IndexedSerializer& serializer, const T& object) {
+    serializer.buffer.clear();
+    detail::writeIndexed(serializer.buffer, object);
+    serializer.writeRecord();
+  }
+
+  /**
+   * Deserializer providing random access to records written by the IndexedSerializer.
+   *
+   * Since the contents are accessed lazily, the deserializer requires the whole serialized data to be in memory (e.g.
+   * memory-mapped) for the whole lifetime of the deserializer and all views derived from it.
+   */
+  class IndexedDeserializer {
+  public:
+    explicit IndexedDeserializer(std::span<const std::byte> data) : data(data) {}
+
+    /**
+     * Returns a lazy view of the next record and advances to the following record.
+     */
+    template <typename T> IndexedView<T> next() { return IndexedView<T>{nextRecord()}; }
+
+    bool empty() const noexcept { return position >= data.size(); }
+
+  private:
+    std::span<const std::byte> nextRecord();
+
+    std::span<const std::byte> data;
+    std::size_t position = 0;
+  };
+} // namespace serialize
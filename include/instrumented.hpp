@@ -0,0 +1,281 @@
+/*
+ * Serialization wrappers recording the number of values, bytes and time per type.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "skip.hpp"
+#include "type_safe.hpp"
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+namespace serialize {
+
+  /**
+   * The accumulated number of values, bytes and time (if measured) of a single type.
+   */
+  struct InstrumentationCounters {
+    std::size_t numValues = 0;
+    std::size_t numBytes = 0;
+    std::chrono::nanoseconds duration{0};
+
+    auto operator<=>(const InstrumentationCounters& other) const noexcept = default;
+  };
+
+  /**
+   * Recorded counters of an InstrumentedSerializer or InstrumentedDeserializer.
+   */
+  struct InstrumentationReport {
+    static constexpr std::size_t NUM_FUNDAMENTAL_TYPES = 17;
+
+    /**
+     * Counters for every fundamental type, indexed by their type id (see type_safe.hpp).
+     */
+    std::array<InstrumentationCounters, NUM_FUNDAMENTAL_TYPES> fundamentals{};
+    /**
+     * Counters for the contiguous ranges written as raw memory (e.g. by the SimpleStreamSerializer), including their
+     * sizes.
+     */
+    InstrumentationCounters rawData{};
+    /**
+     * Counters for the top-level objects (de)serialized via the serializeObject() or deserializeObject() functions,
+     * keyed by the (demangled) type name.
+     */
+    std::map<std::string, InstrumentationCounters, std::less<>> objects{};
+    /**
+     * The number of bytes written or read by the inner (de)serializer in total (including flushed data).
+     */
+    std::size_t totalBytes = 0;
+
+    template <typename T> const InstrumentationCounters& fundamental() const noexcept {
+      return fundamentals[detail::type_id_v<T>];
+    }
+
+    template <typename T> InstrumentationCounters object() const;
+  };
+
+  /**
+   * Writes the given report as human-readable table.
+   */
+  std::ostream& operator<<(std::ostream& os, const InstrumentationReport& report);
+
+  namespace detail {
+    std::string demangleTypeName(const char* name);
+
+    template <typename T> std::string typeName() { return demangleTypeName(typeid(T).name()); }
+
+    /**
+     * Stream buffer forwarding all output to another stream buffer and counting the number of bytes written.
+     */
+    class CountingOutputBuffer : public std::streambuf {
+    public:
+      explicit CountingOutputBuffer(std::streambuf* target) noexcept : target(target) {}
+
+      std::size_t count() const noexcept { return numBytes; }
+
+    protected:
+      int_type overflow(int_type ch) override;
+      std::streamsize xsputn(const char_type* s, std::streamsize count) override;
+      int sync() override;
+
+    private:
+      std::streambuf* target;
+      std::size_t numBytes = 0;
+    };
+
+    /**
+     * Unbuffered stream buffer forwarding all input from another stream buffer and counting the number of bytes read.
+     */
+    class CountingInputBuffer : public std::streambuf {
+    public:
+      explicit CountingInputBuffer(std::streambuf* target) noexcept : target(target) {}
+
+      std::size_t count() const noexcept { return numBytes; }
+
+    protected:
+      int_type underflow() override;
+      int_type uflow() override;
+      std::streamsize xsgetn(char_type* s, std::streamsize count) override;
+      std::streamsize showmanyc() override;
+
+    private:
+      std::streambuf* target;
+      std::size_t numBytes = 0;
+    };
+
+    /**
+     * Records the bytes (and time) spent between construction and destruction into the given counters.
+     */
+    template <typename Buffer, bool MeasureTime> class InstrumentationScope {
+    public:
+      InstrumentationScope(const Buffer& buffer, InstrumentationCounters& counters) noexcept
+          : buffer(buffer), counters(counters), startBytes(buffer.count()) {
+        ++counters.numValues;
+        if constexpr (MeasureTime) {
+          start = std::chrono::steady_clock::now();
+        }
+      }
+
+      InstrumentationScope(const InstrumentationScope&) = delete;
+      InstrumentationScope& operator=(const InstrumentationScope&) = delete;
+
+      ~InstrumentationScope() noexcept {
+        counters.numBytes += buffer.count() - startBytes;
+        if constexpr (MeasureTime) {
+          counters.duration += std::chrono::steady_clock::now() - start;
+        }
+      }
+
+    private:
+      const Buffer& buffer;
+      InstrumentationCounters& counters;
+      std::size_t startBytes;
+      std::conditional_t<MeasureTime, std::chrono::steady_clock::time_point, std::byte> start{};
+    };
+  } // namespace detail
+
+  template <typename T> InstrumentationCounters InstrumentationReport::object() const {
+    auto it = objects.find(detail::typeName<T>());
+    return it != objects.end() ? it->second : InstrumentationCounters{};
+  }
+
+  /**
+   * Wrapper around any stream-based Serializer recording the number of values written, the number of bytes emitted by
+   * the inner serializer and optionally the time spent, per fundamental type and per top-level object type.
+   *
+   * NOTE: For serializers buffering partial bytes (e.g. the BitPackingSinkSerializer), the bytes are attributed to the
+   * value completing them, i.e. only the total over all types is exact.
+   *
+   * NOTE: Without wrapping a serializer in this type, there is no overhead at all. With the template parameter
+   * MeasureTime set to false (default), no clock is ever queried.
+   */
+  template <Serializer Inner, bool MeasureTime = false>
+    requires(std::constructible_from<Inner, std::ostream&>)
+  class InstrumentedSerializer {
+    using Scope = detail::InstrumentationScope<detail::CountingOutputBuffer, MeasureTime>;
+
+  public:
+    explicit InstrumentedSerializer(std::ostream& os) : buffer(os.rdbuf()), out(&buffer), inner(out) {}
+
+    InstrumentedSerializer(const InstrumentedSerializer&) = delete;
+    InstrumentedSerializer(InstrumentedSerializer&&) noexcept = delete;
+    ~InstrumentedSerializer() noexcept = default;
+
+    InstrumentedSerializer& operator=(const InstrumentedSerializer&) = delete;
+    InstrumentedSerializer& operator=(InstrumentedSerializer&&) noexcept = delete;
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) {
+      Scope scope{buffer, counters.fundamentals[detail::type_id_v<T>]};
+      inner.write(val);
+    }
+
+    void write(std::size_t numElements, std::span<const std::byte> data)
+      requires(ByteSerializer<Inner>)
+    {
+      Scope scope{buffer, counters.rawData};
+      inner.write(numElements, data);
+    }
+
+    void flush() {
+      inner.flush();
+      out.flush();
+    }
+
+    /**
+     * Serializes the given object, additionally attributing the values, bytes and time to the object's type.
+     */
+    template <typename T> void serializeObject(const T& object) {
+      Scope scope{buffer, counters.objects[detail::typeName<T>()]};
+      serialize(*this, object);
+    }
+
+    /**
+     * Returns the counters recorded so far.
+     */
+    InstrumentationReport report() const {
+      auto result = counters;
+      result.totalBytes = buffer.count();
+      return result;
+    }
+
+  private:
+    detail::CountingOutputBuffer buffer;
+    std::ostream out;
+    Inner inner;
+    InstrumentationReport counters;
+  };
+
+  /**
+   * Wrapper around any stream-based Deserializer recording the number of values read, the number of bytes consumed by
+   * the inner deserializer and optionally the time spent, per fundamental type and per top-level object type.
+   *
+   * NOTE: For deserializers reading ahead or buffering partial bytes (e.g. the BitPackingSourceDeserializer), the bytes
+   * are attributed to the value triggering the read, i.e. only the total over all types is exact.
+   */
+  template <Deserializer Inner, bool MeasureTime = false>
+    requires(std::constructible_from<Inner, std::istream&>)
+  class InstrumentedDeserializer {
+    using Scope = detail::InstrumentationScope<detail::CountingInputBuffer, MeasureTime>;
+
+  public:
+    explicit InstrumentedDeserializer(std::istream& is) : buffer(is.rdbuf()), in(&buffer), inner(in) {}
+
+    InstrumentedDeserializer(const InstrumentedDeserializer&) = delete;
+    InstrumentedDeserializer(InstrumentedDeserializer&&) noexcept = delete;
+    ~InstrumentedDeserializer() noexcept = default;
+
+    InstrumentedDeserializer& operator=(const InstrumentedDeserializer&) = delete;
+    InstrumentedDeserializer& operator=(InstrumentedDeserializer&&) noexcept = delete;
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> read(T& val) {
+      Scope scope{buffer, counters.fundamentals[detail::type_id_v<T>]};
+      inner.read(val);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues)
+      requires(SkippingDeserializer<Inner>)
+    {
+      inner.template skip<T>(numValues);
+    }
+
+    /**
+     * Deserializes an object of the given type, additionally attributing the values, bytes and time to the type.
+     */
+    template <typename T> T deserializeObject() {
+      Scope scope{buffer, counters.objects[detail::typeName<T>()]};
+      return deserialize<T>(*this);
+    }
+
+    /**
+     * Returns the counters recorded so far.
+     */
+    InstrumentationReport report() const {
+      auto result = counters;
+      result.totalBytes = buffer.count();
+      return result;
+    }
+
+  private:
+    detail::CountingInputBuffer buffer;
+    std::istream in;
+    Inner inner;
+    InstrumentationReport counters;
+  };
+
+} // namespace serialize
@@ -0,0 +1,183 @@
+/*
+ * String interning serialization wrappers, writing repeated strings as back-references.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "skip.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * The string follows inline and is not added to the table of interned strings.
+     */
+    static constexpr std::size_t INTERNED_INLINE = 0;
+    /**
+     * The string follows inline and is added as next entry to the table of interned strings.
+     */
+    static constexpr std::size_t INTERNED_NEW = 1;
+    /**
+     * Any larger value references the table entry with the index of the value minus this offset.
+     */
+    static constexpr std::size_t INTERNED_REFERENCE_OFFSET = 2;
+
+    [[noreturn]] void throwOnInvalidInternedReference(std::size_t index, std::size_t numEntries);
+  } // namespace detail
+
+  /**
+   * Wrapper around any other Serializer writing repeated strings as back-references to their first occurrence.
+   *
+   * Every std::string and std::string_view serialized via this serializer (also as part of containers or aggregates)
+   * is checked against the table of strings already written. The first occurrence of a string is written as-is and
+   * added to the table, any further occurrence is written as the table index only.
+   *
+   * The table of strings can be limited to a maximum number of entries, after which any new strings are written as-is
+   * without being added to the table.
+   */
+  template <Serializer Inner> class StringInterningSerializer {
+  public:
+    static constexpr std::size_t UNLIMITED_ENTRIES = std::numeric_limits<std::size_t>::max();
+
+    explicit StringInterningSerializer(Inner& inner, std::size_t maxEntries = UNLIMITED_ENTRIES)
+        : inner(inner), maxEntries(maxEntries) {}
+
+    explicit StringInterningSerializer(Inner&& inner, std::size_t maxEntries = UNLIMITED_ENTRIES)
+        : innerHolder(std::make_unique<Inner>(std::move(inner))), inner(*innerHolder), maxEntries(maxEntries) {}
+
+    explicit StringInterningSerializer(std::unique_ptr<Inner>&& inner, std::size_t maxEntries = UNLIMITED_ENTRIES)
+        : innerHolder(std::move(inner)), inner(*innerHolder), maxEntries(maxEntries) {
+      if (!innerHolder)
+        throw std::invalid_argument{"Cannot wrap a NULL serializer object"};
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> write(T val) { inner.write(val); }
+
+    void write(std::size_t numElements, std::span<const std::byte> data)
+      requires ByteSerializer<Inner>
+    {
+      inner.write(numElements, data);
+    }
+
+    /**
+     * Writes the given string, either as back-reference to an earlier occurrence or as-is.
+     */
+    void writeInterned(std::string_view string) {
+      if (auto it = entries.find(string); it != entries.end()) {
+        serialize(inner, it->second + detail::INTERNED_REFERENCE_OFFSET);
+        return;
+      }
+      if (strings.size() < maxEntries) {
+        // the deque never moves its elements, so the views into them stay valid
+        const auto& entry = strings.emplace_back(string);
+        entries.emplace(entry, strings.size() - 1);
+        serialize(inner, detail::INTERNED_NEW);
+      } else {
+        serialize(inner, detail::INTERNED_INLINE);
+      }
+      serialize(inner, string);
+    }
+
+    /**
+     * Returns the number of strings in the table of interned strings.
+     */
+    std::size_t numEntries() const noexcept { return strings.size(); }
+
+    void flush() { inner.flush(); }
+
+  private:
+    std::unique_ptr<Inner> innerHolder;
+    Inner& inner;
+    std::size_t maxEntries;
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, std::size_t> entries;
+  };
+
+  /**
+   * Wrapper around any other Deserializer reading the strings written by a StringInterningSerializer.
+   *
+   * The deserializer keeps the matching table of interned strings. Strings can be deserialized as std::string_view
+   * referencing the table entries, which stay valid for the lifetime of this deserializer, to avoid allocating memory
+   * for repeated strings. Strings written as-is without being added to the table are only valid until the next string
+   * is read.
+   *
+   * This deserializer is a StringDeserializer, i.e. it reads all std::string and std::string_view objects (also as part
+   * of containers or aggregates) itself. Skipped strings are still added to the table to keep the back-references of
+   * following strings valid.
+   *
+   * Invalid back-references are reported by throwing a std::domain_error.
+   */
+  template <Deserializer Inner> class StringInterningDeserializer {
+  public:
+    explicit StringInterningDeserializer(Inner& inner) : inner(inner) {}
+
+    explicit StringInterningDeserializer(Inner&& inner)
+        : innerHolder(std::make_unique<Inner>(std::move(inner))), inner(*innerHolder) {}
+
+    explicit StringInterningDeserializer(std::unique_ptr<Inner>&& inner)
+        : innerHolder(std::move(inner)), inner(*innerHolder) {
+      if (!innerHolder)
+        throw std::invalid_argument{"Cannot wrap a NULL deserializer object"};
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> read(T& val) { inner.read(val); }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues) {
+      detail::skipValues<T>(inner, numValues);
+    }
+
+    /**
+     * Reads the next string, resolving back-references to earlier occurrences.
+     */
+    std::string_view readString() {
+      auto marker = deserialize<std::size_t>(inner);
+      if (marker >= detail::INTERNED_REFERENCE_OFFSET) {
+        auto index = marker - detail::INTERNED_REFERENCE_OFFSET;
+        if (index >= strings.size()) {
+          detail::throwOnInvalidInternedReference(index, strings.size());
+        }
+        return strings[index];
+      }
+      if (marker == detail::INTERNED_NEW) {
+        return strings.emplace_back(deserialize<std::string>(inner));
+      }
+      lastInline = deserialize<std::string>(inner);
+      return lastInline;
+    }
+
+    /**
+     * Returns the number of strings in the table of interned strings.
+     */
+    std::size_t numEntries() const noexcept { return strings.size(); }
+
+  private:
+    std::unique_ptr<Inner> innerHolder;
+    Inner& inner;
+    std::deque<std::string> strings;
+    std::string lastInline;
+  };
+
+  template <Serializer Inner> void serialize(StringInterningSerializer<Inner>& serializer, const std::string& string) {
+    serializer.writeInterned(string);
+  }
+
+  template <Serializer Inner> void serialize(StringInterningSerializer<Inner>& serializer, std::string_view string) {
+    serializer.writeInterned(string);
+  }
+
+} // namespace serialize
@@ -0,0 +1,162 @@
+/*
+ * Wrapper types serializing floating-point values with reduced precision.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "serialize.hpp"
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+namespace serialize {
+
+  namespace detail {
+    /**
+     * Converts the given value to the nearest IEEE 754 half-precision value (ties to even), using the F16C
+     * instructions if enabled for the target.
+     */
+    uint16_t floatToHalf(float value) noexcept;
+    float halfToFloat(uint16_t bits) noexcept;
+
+    /**
+     * Converts the given value to the nearest bfloat16 value (ties to even), i.e. the upper 16 bits of the float.
+     */
+    constexpr uint16_t floatToBFloat16(float value) noexcept {
+      auto bits = std::bit_cast<uint32_t>(value);
+      if ((bits & 0x7FFFFFFFU) > 0x7F800000U) {
+        // keep NaN a (quiet) NaN, the rounding could overflow into the infinity bit pattern
+        return static_cast<uint16_t>((bits >> 16) | 0x0040U);
+      }
+      bits += 0x7FFFU + ((bits >> 16) & 1U);
+      return static_cast<uint16_t>(bits >> 16);
+    }
+
+    constexpr float bFloat16ToFloat(uint16_t bits) noexcept {
+      return std::bit_cast<float>(static_cast<uint32_t>(bits) << 16);
+    }
+
+    [[noreturn]] void throwOnQuantizationOverflow(long double value);
+
+    template <typename T> constexpr bool is_ratio_v = false;
+    template <std::intmax_t Num, std::intmax_t Den> constexpr bool is_ratio_v<std::ratio<Num, Den>> = true;
+  } // namespace detail
+
+  /**
+   * Floating-point value serialized as IEEE 754 half-precision value, i.e. 16 bits with 11 significant bits
+   * (about 3 decimal digits) and a maximum magnitude of 65504. Larger values are written as infinity.
+   *
+   * NOTE: Only the serialized value has the reduced precision, the wrapped value is kept as-is.
+   */
+  template <std::floating_point T> class Half {
+  public:
+    constexpr Half() noexcept = default;
+    constexpr Half(T value) noexcept : val(value) {}
+
+    constexpr operator T() const noexcept { return val; }
+    constexpr T value() const noexcept { return val; }
+
+    template <Serializer S> void serialize(S& serializer) const {
+      serializer.write(detail::floatToHalf(static_cast<float>(val)));
+    }
+
+    template <Deserializer D> void deserialize(D& deserializer) {
+      uint16_t bits{};
+      deserializer.read(bits);
+      val = static_cast<T>(detail::halfToFloat(bits));
+    }
+
+    constexpr auto operator<=>(const Half& other) const noexcept = default;
+
+  private:
+    T val{};
+  };
+
+  /**
+   * Floating-point value serialized as bfloat16 value, i.e. 16 bits with the full single-precision exponent range but
+   * only 8 significant bits (about 2 decimal digits).
+   *
+   * NOTE: Only the serialized value has the reduced precision, the wrapped value is kept as-is.
+   */
+  template <std::floating_point T> class BFloat16 {
+  public:
+    constexpr BFloat16() noexcept = default;
+    constexpr BFloat16(T value) noexcept : val(value) {}
+
+    constexpr operator T() const noexcept { return val; }
+    constexpr T value() const noexcept { return val; }
+
+    template <Serializer S> void serialize(S& serializer) const {
+      serializer.write(detail::floatToBFloat16(static_cast<float>(val)));
+    }
+
+    template <Deserializer D> void deserialize(D& deserializer) {
+      uint16_t bits{};
+      deserializer.read(bits);
+      val = static_cast<T>(detail::bFloat16ToFloat(bits));
+    }
+
+    constexpr auto operator<=>(const BFloat16& other) const noexcept = default;
+
+  private:
+    T val{};
+  };
+
+  /**
+   * Floating-point value serialized as integral multiple of the given step (a std::ratio, e.g. std::centi for a
+   * precision of 0.01), rounded to the nearest multiple.
+   *
+   * Since the multiple is written as integral value, serializers compressing small integral values (e.g. the
+   * BitPackingSinkSerializer or BytePackingSinkSerializer) write values of small magnitude with only a few bits.
+   * Serializing a value whose multiple is not representable by the integral type (or is NaN or infinite) throws a
+   * std::out_of_range error.
+   *
+   * NOTE: Only the serialized value has the reduced precision, the wrapped value is kept as-is.
+   */
+  template <std::floating_point T, typename Step, std::signed_integral Int = int64_t>
+    requires(detail::is_ratio_v<Step> && Step::num > 0)
+  class Quantized {
+  public:
+    constexpr Quantized() noexcept = default;
+    constexpr Quantized(T value) noexcept : val(value) {}
+
+    constexpr operator T() const noexcept { return val; }
+    constexpr T value() const noexcept { return val; }
+
+    template <Serializer S> void serialize(S& serializer) const { serializer.write(quantize(val)); }
+
+    template <Deserializer D> void deserialize(D& deserializer) {
+      Int multiple{};
+      deserializer.read(multiple);
+      val = static_cast<T>(static_cast<long double>(multiple) * Step::num / Step::den);
+    }
+
+    constexpr auto operator<=>(const Quantized& other) const noexcept = default;
+
+    /**
+     * Returns the nearest multiple of the step for the given value.
+     */
+    static Int quantize(T value) {
+      auto multiple = std::round(static_cast<long double>(value) * Step::den / Step::num);
+      // the upper limit is a power of two and therefore exactly representable
+      if (!(multiple >= static_cast<long double>(std::numeric_limits<Int>::min()) &&
+            multiple < -static_cast<long double>(std::numeric_limits<Int>::min()))) {
+        detail::throwOnQuantizationOverflow(value);
+      }
+      return static_cast<Int>(multiple);
+    }
+
+  private:
+    T val{};
+  };
+
+} // namespace serialize
@@ -0,0 +1,254 @@
+/*
+ * Parallel serialization of large containers and parallel deserialization of length-framed record streams.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "deserialize.hpp"
+#include "framed.hpp"
+#include "serialize.hpp"
+#include "streams.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * The order in which the results of parallel deserialization are passed to the caller.
+   */
+  enum class ResultOrder {
+    /**
+     * Results are passed in the order of the records in the stream.
+     */
+    ORDERED,
+    /**
+     * Results are passed in the order of completion, while records within a single block retain their relative order.
+     * This can increase throughput if the decoding times of the blocks vary.
+     */
+    UNORDERED
+  };
+
+  namespace detail {
+    /**
+     * A block of consecutive frame payloads read from a length-framed stream.
+     */
+    struct FrameBlock {
+      std::vector<std::byte> data;
+      // start offsets of all frames, followed by the end offset of the last frame
+      std::vector<std::size_t> offsets;
+
+      std::size_t size() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+      std::span<const std::byte> frame(std::size_t index) const noexcept {
+        return std::span{data}.subspan(offsets[index], offsets[index + 1] - offsets[index]);
+      }
+    };
+
+    /**
+     * Reads up to the given number of frames into the block, returns whether any frame was read.
+     */
+    bool readFrameBlock(std::istream& in, std::size_t maxFrames, FrameBlock& block);
+
+    template <typename T> struct ParallelBlock {
+      FrameBlock frames;
+      std::vector<T> results;
+      std::exception_ptr error;
+      bool done = false;
+    };
+
+    template <typename T, typename D> void decodeFrameBlock(ParallelBlock<T>& block) {
+      block.results.reserve(block.frames.size());
+      SpanInputStream stream{std::span<const std::byte>{}};
+      for (std::size_t i = 0; i < block.frames.size(); ++i) {
+        stream.reset(block.frames.frame(i));
+        D deserializer{stream};
+        block.results.emplace_back(deserialize<T>(deserializer));
+      }
+    }
+
+    template <typename S> struct ParallelChunk {
+      std::size_t begin;
+      std::size_t end;
+      BufferOutputStream stream;
+      std::optional<S> serializer;
+      std::exception_ptr error;
+      bool done = false;
+    };
+
+    template <typename S, typename C> void encodeChunk(ParallelChunk<S>& chunk, const C& container) {
+      // the serializer is not flushed to keep any pending data (e.g. incomplete bytes) for splicing
+      auto& serializer = chunk.serializer.emplace(chunk.stream);
+      auto it = std::ranges::begin(container) + static_cast<std::ranges::range_difference_t<C>>(chunk.begin);
+      for (std::size_t i = chunk.begin; i < chunk.end; ++i, ++it) {
+        serialize(serializer, *it);
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Serializes the given container by encoding chunks of the given number of elements in parallel on the given thread
+   * pool.
+   *
+   * Each chunk is encoded with its own Serializer instance into a separate buffer and the buffers are then spliced in
+   * order into the given serializer, i.e. the output is identical to sequentially serializing the container. The number
+   * of chunks in flight is limited to bound the memory usage independent of the container size.
+   *
+   * Containers not larger than a single chunk as well as raw data containers written via a ByteSerializer (which are
+   * already written with a single call) are serialized sequentially on the calling thread.
+   *
+   * Any exception thrown while encoding a chunk is rethrown on the calling thread after all in-flight chunks have
+   * finished.
+   */
+  template <SplicingSerializer S, std::ranges::random_access_range C>
+    requires((SerializableContainer<C> || SerializableRawData<C>) && std::constructible_from<S, std::ostream&>)
+  void parallelSerialize(S& serializer, const C& container, ThreadPool& pool, std::size_t elementsPerChunk = 4096) {
+    elementsPerChunk = std::max(elementsPerChunk, std::size_t{1});
+    const std::size_t numElements = std::ranges::size(container);
+    if ((ByteSerializer<S> && SerializableRawData<C>) || numElements <= elementsPerChunk) {
+      serialize(serializer, container);
+      return;
+    }
+
+    const std::size_t maxInFlight = 2 * pool.size() + 1;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::unique_ptr<detail::ParallelChunk<S>>> inFlight;
+    std::size_t nextElement = 0;
+
+    auto waitForChunk = [&]() {
+      std::unique_lock lock{mutex};
+      condition.wait(lock, [&]() { return inFlight.front()->done; });
+      auto chunk = std::move(inFlight.front());
+      inFlight.pop_front();
+      return chunk;
+    };
+
+    serialize(serializer, std::ranges::size(container));
+    try {
+      while (nextElement < numElements || !inFlight.empty()) {
+        while (nextElement < numElements && inFlight.size() < maxInFlight) {
+          auto chunk = std::make_unique<detail::ParallelChunk<S>>();
+          chunk->begin = nextElement;
+          chunk->end = std::min(nextElement + elementsPerChunk, numElements);
+          nextElement = chunk->end;
+          detail::submitInFlight(pool, inFlight, chunk, mutex, condition,
+                                 [&container](auto& item) { detail::encodeChunk(item, container); });
+        }
+        auto chunk = waitForChunk();
+        if (chunk->error) {
+          std::rethrow_exception(chunk->error);
+        }
+        serializer.splice(std::move(*chunk->serializer), chunk->stream.data());
+      }
+    } catch (...) {
+      // the in-flight tasks reference the local variables, so we need to wait for them before leaving this function
+      while (!inFlight.empty()) {
+        std::ignore = waitForChunk();
+      }
+      throw;
+    }
+  }
+
+  /**
+   * Deserializes all records of the given stream written by the FramedStreamWriter in parallel on the given thread
+   * pool and passes the deserialized objects to the consumer.
+   *
+   * The record boundaries are determined on the calling thread, which groups the records into blocks of the given
+   * number of records each. The blocks are then decoded by the worker threads of the pool, each record with its own
+   * Deserializer instance. The number of blocks in flight is limited to bound the memory usage independent of the
+   * stream size.
+   *
+   * The consumer is always invoked on the calling thread and therefore does not need to be thread-safe. Any exception
+   * thrown while reading the stream, decoding the records or by the consumer is rethrown on the calling thread after
+   * all in-flight blocks have finished.
+   */
+  template <typename T, Deserializer D, std::invocable<T&&> Consumer>
+    requires(std::constructible_from<D, std::istream&>)
+  void parallelDeserialize(std::istream& in, ThreadPool& pool, Consumer&& consumer,
+                           ResultOrder order = ResultOrder::ORDERED, std::size_t recordsPerBlock = 1024) {
+    const std::size_t maxInFlight = 2 * pool.size() + 1;
+    recordsPerBlock = std::max(recordsPerBlock, std::size_t{1});
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::unique_ptr<detail::ParallelBlock<T>>> inFlight;
+    bool endOfStream = false;
+
+    auto waitForBlock = [&]() {
+      std::unique_lock lock{mutex};
+      auto it = inFlight.begin();
+      condition.wait(lock, [&]() {
+        if (order == ResultOrder::ORDERED) {
+          return inFlight.front()->done;
+        }
+        it = std::find_if(inFlight.begin(), inFlight.end(), [](const auto& block) { return block->done; });
+        return it != inFlight.end();
+      });
+      auto block = std::move(*it);
+      inFlight.erase(it);
+      return block;
+    };
+
+    try {
+      while (true) {
+        while (!endOfStream && inFlight.size() < maxInFlight) {
+          auto block = std::make_unique<detail::ParallelBlock<T>>();
+          if (!detail::readFrameBlock(in, recordsPerBlock, block->frames)) {
+            endOfStream = true;
+            break;
+          }
+          detail::submitInFlight(pool, inFlight, block, mutex, condition,
+                                 [](auto& item) { detail::decodeFrameBlock<T, D>(item); });
+        }
+        if (inFlight.empty()) {
+          break;
+        }
+        auto block = waitForBlock();
+        if (block->error) {
+          std::rethrow_exception(block->error);
+        }
+        for (auto& result : block->results) {
+          consumer(std::move(result));
+        }
+      }
+    } catch (...) {
+      // the in-flight tasks reference the local variables, so we need to wait for them before leaving this function
+      while (!inFlight.empty()) {
+        std::ignore = waitForBlock();
+      }
+      throw;
+    }
+  }
+
+  /**
+   * Deserializes all records of the given stream written by the FramedStreamWriter in parallel on the given thread
+   * pool and returns them in the requested order.
+   */
+  template <typename T, Deserializer D>
+    requires(std::constructible_from<D, std::istream&>)
+  std::vector<T> parallelDeserialize(std::istream& in, ThreadPool& pool, ResultOrder order = ResultOrder::ORDERED,
+                                     std::size_t recordsPerBlock = 1024) {
+    std::vector<T> results{};
+    parallelDeserialize<T, D>(
+        in, pool, [&results](T&& result) { results.emplace_back(std::move(result)); }, order, recordsPerBlock);
+    return results;
+  }
+
+} // namespace serialize
@@ -0,0 +1,505 @@
+/*
+ * Resumable deserialization of incrementally arriving data via C++20 coroutines.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+#include "streams.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <chrono>
+#include <climits>
+#include <complex>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * Extension of the Deserializer allowing to read values only if they are completely available.
+   */
+  template <typename T>
+  concept IncrementalDeserializer = Deserializer<T> && requires(T obj) {
+    /**
+     * Prototype for a function reading a fundamental value if it is completely available from the underlying source.
+     * Otherwise, returns false and leaves the internal state of the deserializer as before the call. Any data already
+     * taken from the underlying source is not returned, i.e. the caller needs to rewind the source before retrying.
+     */
+    { obj.tryRead(std::declval<uint32_t&>()) } -> std::convertible_to<bool>;
+  };
+
+  /**
+   * The state of a ResumableDeserializer.
+   */
+  enum class ResumeStatus {
+    /**
+     * The data fed so far is not sufficient to complete the current value.
+     */
+    NEED_MORE_DATA,
+    /**
+     * A value has been completely deserialized and can be taken.
+     */
+    COMPLETE
+  };
+
+  namespace detail {
+    /**
+     * Lazily started coroutine deserializing a single (non-fundamental) value, which resumes the awaiting coroutine on
+     * completion.
+     */
+    class ResumeTask {
+    public:
+      struct promise_type {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::exception_ptr error;
+
+        ResumeTask get_return_object() noexcept {
+          return ResumeTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        auto final_suspend() noexcept {
+          struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+              return handle.promise().continuation;
+            }
+            void await_resume() noexcept {}
+          };
+          return FinalAwaiter{};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+      };
+
+      ResumeTask(const ResumeTask&) = delete;
+      ResumeTask(ResumeTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+      ~ResumeTask() noexcept {
+        if (handle) {
+          handle.destroy();
+        }
+      }
+
+      ResumeTask& operator=(const ResumeTask&) = delete;
+      ResumeTask& operator=(ResumeTask&& other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+      }
+
+      bool await_ready() const noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+      }
+
+      void await_resume() const { rethrowError(); }
+
+      /**
+       * Runs the coroutine until it completes or suspends, returns whether it completed.
+       */
+      bool start() {
+        handle.resume();
+        return handle.done();
+      }
+
+      bool done() const noexcept { return handle.done(); }
+
+      void rethrowError() const {
+        if (handle.promise().error) {
+          std::rethrow_exception(handle.promise().error);
+        }
+      }
+
+    private:
+      explicit ResumeTask(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+      std::coroutine_handle<promise_type> handle;
+    };
+
+    /**
+     * Input state shared by all coroutines deserializing a single top-level value.
+     */
+    template <typename D> class ResumeContext {
+    public:
+      ResumeContext() : stream(std::span<const std::byte>{}), deserializer(stream) {}
+
+      template <typename T> bool tryRead(T& val) {
+        auto position = stream.position();
+        try {
+          if (deserializer.tryRead(val)) {
+            return true;
+          }
+        } catch (...) {
+          rewind(position);
+          throw;
+        }
+        // rewind any partially read data
+        rewind(position);
+        return false;
+      }
+
+      void append(std::span<const std::byte> data) {
+        // drop the already consumed data
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(stream.position()));
+        buffer.insert(buffer.end(), data.begin(), data.end());
+        stream.reset(buffer);
+      }
+
+      std::size_t numBuffered() const noexcept { return buffer.size() - stream.position(); }
+
+      /**
+       * Retries the pending read and resumes the suspended coroutine on success, returns whether the read succeeded.
+       */
+      bool resumePending() {
+        if (!pending || !retry(retryArgument)) {
+          return false;
+        }
+        std::exchange(pending, {}).resume();
+        return true;
+      }
+
+      void suspend(std::coroutine_handle<> handle, bool (*retryFunc)(void*), void* argument) noexcept {
+        pending = handle;
+        retry = retryFunc;
+        retryArgument = argument;
+      }
+
+      void reset() noexcept { pending = {}; }
+
+    private:
+      void rewind(std::size_t position) {
+        stream.clear();
+        stream.seekg(static_cast<std::streamoff>(position));
+      }
+
+      std::vector<std::byte> buffer;
+      SpanInputStream stream;
+      D deserializer;
+      std::coroutine_handle<> pending;
+      bool (*retry)(void*) = nullptr;
+      void* retryArgument = nullptr;
+    };
+
+    /**
+     * Awaitable reading a single fundamental value, which only suspends if the value is not completely available.
+     */
+    template <typename D, typename T> struct ReadAwaiter {
+      ResumeContext<D>& context;
+      T& value;
+      std::exception_ptr error{};
+
+      bool await_ready() { return context.tryRead(value); }
+
+      void await_suspend(std::coroutine_handle<> handle) noexcept {
+        context.suspend(
+            handle, [](void* self) { return static_cast<ReadAwaiter*>(self)->retry(); }, this);
+      }
+
+      void await_resume() const {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+
+      bool retry() noexcept {
+        try {
+          return await_ready();
+        } catch (...) {
+          // the retry is run outside of the coroutine, so resume it to rethrow the error inside, see #await_resume
+          error = std::current_exception();
+          return true;
+        }
+      }
+    };
+
+    template <typename T> struct is_pair : std::false_type {};
+    template <typename F, typename S> struct is_pair<std::pair<F, S>> : std::true_type {};
+
+    template <typename D, typename T> ResumeTask resumableInto(ResumeContext<D>& context, T& out);
+
+    /**
+     * Returns the awaitable deserializing the given object, which for fundamental types avoids the overhead of a
+     * separate coroutine.
+     */
+    template <typename D, typename T> auto resumableAwaitable(ResumeContext<D>& context, T& out) {
+      if constexpr (std::is_fundamental_v<T>) {
+        return ReadAwaiter<D, T>{context, out};
+      } else {
+        return resumableInto(context, out);
+      }
+    }
+
+    template <typename D, typename Tuple, std::size_t... Indices>
+    ResumeTask resumableElements(ResumeContext<D>& context, Tuple elements, std::index_sequence<Indices...>) {
+      (co_await resumableAwaitable(context, std::get<Indices>(elements)), ...);
+    }
+
+    template <typename D, typename T, std::size_t Index>
+    ResumeTask resumableAlternative(ResumeContext<D>& context, T& out) {
+      std::variant_alternative_t<Index, T> tmp{};
+      co_await resumableAwaitable(context, tmp);
+      out.template emplace<Index>(std::move(tmp));
+    }
+
+    template <typename D, typename T, std::size_t... Indices>
+    ResumeTask resumableVariant(ResumeContext<D>& context, T& out, std::size_t index, std::index_sequence<Indices...>) {
+      static constexpr std::array<ResumeTask (*)(ResumeContext<D>&, T&), sizeof...(Indices)> ALTERNATIVES{
+          &resumableAlternative<D, T, Indices>...};
+      return ALTERNATIVES.at(index)(context, out);
+    }
+
+    template <typename T> struct is_variant : std::false_type {};
+    template <typename... Args> struct is_variant<std::variant<Args...>> : std::true_type {};
+    template <typename T> struct is_unique_ptr : std::false_type {};
+    template <typename T> struct is_unique_ptr<std::unique_ptr<T>> : std::true_type {};
+    template <typename T> struct is_optional : std::false_type {};
+    template <typename T> struct is_optional<std::optional<T>> : std::true_type {};
+    template <typename T> struct is_atomic : std::false_type {};
+    template <typename T> struct is_atomic<std::atomic<T>> : std::true_type {};
+    template <typename T> struct is_duration : std::false_type {};
+    template <typename R, typename P> struct is_duration<std::chrono::duration<R, P>> : std::true_type {};
+    template <typename T> struct is_time_point : std::false_type {};
+    template <typename C, typename Dur> struct is_time_point<std::chrono::time_point<C, Dur>> : std::true_type {};
+    template <typename T> struct is_complex : std::false_type {};
+    template <typename T> struct is_complex<std::complex<T>> : std::true_type {};
+    template <typename T> struct is_bitset : std::false_type {};
+    template <std::size_t N> struct is_bitset<std::bitset<N>> : std::true_type {
+      static constexpr std::size_t SIZE = N;
+    };
+    template <typename T> struct is_bool_vector : std::false_type {};
+    template <typename Alloc> struct is_bool_vector<std::vector<bool, Alloc>> : std::true_type {};
+
+    /**
+     * Coroutine deserializing into the given object, mirroring the layout read by the deserialize() functions.
+     */
+    template <typename D, typename T> ResumeTask resumableInto(ResumeContext<D>& context, T& out) {
+      if constexpr (std::is_fundamental_v<T>) {
+        co_await ReadAwaiter<D, T>{context, out};
+      } else if constexpr (std::is_same_v<T, std::byte>) {
+        uint8_t tmp = 0;
+        co_await ReadAwaiter<D, uint8_t>{context, tmp};
+        out = std::bit_cast<std::byte>(tmp);
+      } else if constexpr (is_atomic<T>::value) {
+        typename T::value_type tmp{};
+        co_await resumableAwaitable(context, tmp);
+        out.store(tmp);
+      } else if constexpr (is_duration<T>::value) {
+        typename T::rep tmp{};
+        co_await resumableAwaitable(context, tmp);
+        out = T{tmp};
+      } else if constexpr (is_time_point<T>::value) {
+        typename T::duration tmp{};
+        co_await resumableAwaitable(context, tmp);
+        out = T{tmp};
+      } else if constexpr (is_complex<T>::value) {
+        typename T::value_type real{};
+        typename T::value_type imag{};
+        co_await ReadAwaiter<D, typename T::value_type>{context, real};
+        co_await ReadAwaiter<D, typename T::value_type>{context, imag};
+        out = T{real, imag};
+      } else if constexpr (is_optional<T>::value || is_unique_ptr<T>::value) {
+        bool hasValue = false;
+        co_await ReadAwaiter<D, bool>{context, hasValue};
+        if (hasValue) {
+          std::remove_cvref_t<decltype(*out)> tmp{};
+          co_await resumableAwaitable(context, tmp);
+          if constexpr (is_optional<T>::value) {
+            out.emplace(std::move(tmp));
+          } else {
+            out = std::make_unique<std::remove_cvref_t<decltype(*out)>>(std::move(tmp));
+          }
+        } else {
+          out.reset();
+        }
+      } else if constexpr (is_fixed_size_container_v<T>) {
+        std::size_t size = 0;
+        co_await ReadAwaiter<D, std::size_t>{context, size};
+        if (size != std::size(out)) {
+          throw std::out_of_range{"Number of elements does not match the fixed container size"};
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+          co_await resumableAwaitable(context, out[i]);
+        }
+      } else if constexpr (is_bool_vector<T>::value) {
+        std::size_t size = 0;
+        co_await ReadAwaiter<D, std::size_t>{context, size};
+        out.assign(size, false);
+        uint8_t tmp = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+          if (i % 8 == 0) {
+            co_await ReadAwaiter<D, uint8_t>{context, tmp};
+          }
+          out[i] = tmp & (1 << i % CHAR_BIT);
+        }
+      } else if constexpr (DeserializableGrowableContainer<T>) {
+        using ValueType = std::ranges::range_value_t<T>;
+        using SizeType = decltype(std::ranges::size(std::declval<T>()));
+        SizeType size = 0;
+        co_await ReadAwaiter<D, SizeType>{context, size};
+        out = T{};
+        if constexpr (requires(T obj) { obj.reserve(std::declval<SizeType>()); }) {
+          out.reserve(size);
+        }
+        for (SizeType i = 0; i < size; ++i) {
+          std::optional<ValueType> element{};
+          if constexpr (is_pair<ValueType>::value) {
+            // e.g. std::map with constant key type
+            std::remove_cv_t<typename ValueType::first_type> first{};
+            std::remove_cv_t<typename ValueType::second_type> second{};
+            co_await resumableAwaitable(context, first);
+            co_await resumableAwaitable(context, second);
+            element.emplace(std::move(first), std::move(second));
+          } else {
+            co_await resumableAwaitable(context, element.emplace());
+          }
+          if constexpr (requires(T obj) { obj.emplace(std::declval<ValueType>()); }) {
+            out.emplace(std::move(*element));
+          } else {
+            out.push_back(std::move(*element));
+          }
+        }
+      } else if constexpr (TupleType<T>) {
+        co_await resumableElements(context, std::apply([](auto&... elements) { return std::tie(elements...); }, out),
+                                   std::make_index_sequence<std::tuple_size_v<T>>{});
+      } else if constexpr (is_variant<T>::value) {
+        std::size_t index = 0;
+        co_await ReadAwaiter<D, std::size_t>{context, index};
+        if (index >= std::variant_size_v<T>) {
+          throw std::runtime_error{"Cannot deserialize valueless_by_exception variant object"};
+        }
+        co_await resumableVariant(context, out, index, std::make_index_sequence<std::variant_size_v<T>>{});
+      } else if constexpr (is_bitset<T>::value) {
+        constexpr auto N = is_bitset<T>::SIZE;
+        if constexpr (!std::is_same_v<EnclosingUnsignedType<N>, void>) {
+          EnclosingUnsignedType<N> tmp{};
+          co_await ReadAwaiter<D, EnclosingUnsignedType<N>>{context, tmp};
+          out = T{tmp};
+        } else {
+          uint8_t tmp = 0;
+          for (std::size_t i = 0; i < N; ++i) {
+            if (i % 8 == 0) {
+              co_await ReadAwaiter<D, uint8_t>{context, tmp};
+            }
+            out.set(i, tmp & (1 << i % CHAR_BIT));
+          }
+        }
+      } else if constexpr (StructuredBindingDeserializable<T>) {
+        co_await resumableElements(context, applyToMembers(out, [](auto&... members) { return std::tie(members...); }),
+                                   std::make_index_sequence<memberCount<T>>{});
+      } else {
+        // Custom deserialize() functions directly read from the deserializer and therefore cannot be suspended
+        static_assert(sizeof(T) == 0, "Type is not supported for resumable deserialization");
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Deserializer decoding values from incrementally arriving data (e.g. network packets), which suspends whenever the
+   * data fed so far is exhausted and resumes exactly at that point as soon as more data is fed.
+   *
+   * Deserialization is implemented as a tree of C++20 coroutines mirroring the deserialize() functions. Values are only
+   * read if they are completely available, so no data is decoded twice and no exceptions are thrown to signal missing
+   * data.
+   *
+   * Supported are all fundamental types, the standard library types supported by deserialize() as well as aggregate
+   * types deserializable via structured bindings. Types with custom deserialize() functions are not supported.
+   *
+   * NOTE: The deserializer object must not be moved while a value is being decoded.
+   */
+  template <typename T, IncrementalDeserializer D>
+    requires(std::constructible_from<D, std::istream&> && std::default_initializable<T>)
+  class ResumableDeserializer {
+  public:
+    ResumableDeserializer() = default;
+    ResumableDeserializer(const ResumableDeserializer&) = delete;
+    ResumableDeserializer& operator=(const ResumableDeserializer&) = delete;
+
+    /**
+     * Appends the given data and continues deserializing the current value.
+     *
+     * Already completely fed values need to be retrieved via #take() before more data can be fed. Any data exceeding
+     * the current value is kept for the following values, which can be deserialized by feeding an empty span.
+     *
+     * Errors in the deserialized data (e.g. type mismatches) are thrown as exceptions, which drops the current value.
+     * Errors thrown while reading a fundamental value leave the input at the start of that value.
+     */
+    ResumeStatus feed(std::span<const std::byte> data) {
+      if (result) {
+        throw std::logic_error{"Previous value needs to be taken before feeding more data"};
+      }
+      context.append(data);
+      if (!task) {
+        task.emplace(run());
+        complete(task->start());
+      } else if (context.resumePending()) {
+        complete(task->done());
+      }
+      return status();
+    }
+
+    ResumeStatus status() const noexcept { return result ? ResumeStatus::COMPLETE : ResumeStatus::NEED_MORE_DATA; }
+
+    /**
+     * Returns the completely deserialized value.
+     */
+    T take() {
+      if (!result) {
+        throw std::logic_error{"Value is not completely deserialized yet"};
+      }
+      T value = std::move(*result);
+      result.reset();
+      return value;
+    }
+
+    /**
+     * Returns the number of bytes fed but not yet consumed.
+     */
+    std::size_t numBuffered() const noexcept { return context.numBuffered(); }
+
+  private:
+    detail::ResumeTask run() {
+      T tmp{};
+      co_await detail::resumableAwaitable(context, tmp);
+      result.emplace(std::move(tmp));
+    }
+
+    void complete(bool done) {
+      if (!done) {
+        return;
+      }
+      auto finishedTask = std::move(*task);
+      task.reset();
+      context.reset();
+      finishedTask.rethrowError();
+    }
+
+    detail::ResumeContext<D> context;
+    std::optional<detail::ResumeTask> task;
+    std::optional<T> result;
+  };
+
+} // namespace serialize
@@ -9,10 +9,13 @@
 
 #include "common.hpp"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <bitset>
 #include <chrono>
 #include <complex>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -23,6 +26,7 @@
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace serialize {
 
@@ -69,48 +73,104 @@ namespace serialize {
     obj.write(std::declval<std::size_t>(), std::declval<std::span<const std::byte>>());
   };
 
+  /**
+   * Extension of the Serializer writing the native representation of fundamental values and allowing to write the
+   * concatenated native representation of multiple values at once.
+   */
+  template <typename T>
+  concept NativeBlockSerializer =
+      Serializer<T> && requires(T obj) { obj.writeNative(std::declval<std::span<const std::byte>>()); };
+
+  /**
+   * Extension of the Serializer allowing to append the output of another instance of the same serializer type, e.g. to
+   * concatenate data serialized in parallel.
+   */
+  template <typename T>
+  concept SplicingSerializer = Serializer<T> && requires(T obj) {
+    /**
+     * Prototype for a function appending the given bytes already written to its sink by the other serializer followed
+     * by any data still pending in the other serializer, as if all of it was written by this serializer.
+     */
+    obj.splice(std::declval<T&&>(), std::declval<std::span<const std::byte>>());
+  };
+
   // Fundamental types
-  template <Serializer S> void serialize(S& serializer, bool b) { serializer.write(b); }
-  template <Serializer S> void serialize(S& serializer, int8_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, uint8_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, int16_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, uint16_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, int32_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, uint32_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, int64_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, uint64_t i) { serializer.write(i); }
-  template <Serializer S> void serialize(S& serializer, float f) { serializer.write(f); }
-  template <Serializer S> void serialize(S& serializer, double f) { serializer.write(f); }
-  template <Serializer S> void serialize(S& serializer, long double f) { serializer.write(f); }
-  template <Serializer S> void serialize(S& serializer, char c) { serializer.write(c); }
-  template <Serializer S> void serialize(S& serializer, wchar_t c) { serializer.write(c); }
-  template <Serializer S> void serialize(S& serializer, char16_t c) { serializer.write(c); }
-  template <Serializer S> void serialize(S& serializer, char32_t c) { serializer.write(c); }
-  template <Serializer S> void serialize(S& serializer, char8_t c) { serializer.write(c); }
-  template <Serializer S> void serialize(S& serializer, std::byte b) { serializer.write(std::bit_cast<uint8_t>(b)); }
+  template <Serializer S> constexpr void serialize(S& serializer, bool b) { serializer.write(b); }
+  template <Serializer S> constexpr void serialize(S& serializer, int8_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, uint8_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, int16_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, uint16_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, int32_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, uint32_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, int64_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, uint64_t i) { serializer.write(i); }
+  template <Serializer S> constexpr void serialize(S& serializer, float f) { serializer.write(f); }
+  template <Serializer S> constexpr void serialize(S& serializer, double f) { serializer.write(f); }
+  template <Serializer S> constexpr void serialize(S& serializer, long double f) { serializer.write(f); }
+  template <Serializer S> constexpr void serialize(S& serializer, char c) { serializer.write(c); }
+  template <Serializer S> constexpr void serialize(S& serializer, wchar_t c) { serializer.write(c); }
+  template <Serializer S> constexpr void serialize(S& serializer, char16_t c) { serializer.write(c); }
+  template <Serializer S> constexpr void serialize(S& serializer, char32_t c) { serializer.write(c); }
+  template <Serializer S> constexpr void serialize(S& serializer, char8_t c) { serializer.write(c); }
+  template <Serializer S> constexpr void serialize(S& serializer, std::byte b) {
+    serializer.write(std::bit_cast<uint8_t>(b));
+  }
+
+  namespace detail {
+    /**
+     * Writes the given packed bits (or other bytes) as a sequence of uint8_t values, in a single block if supported by
+     * the serializer.
+     */
+    template <Serializer S> constexpr void writePackedBytes(S& serializer, std::span<const std::byte> bytes) {
+      if constexpr (NativeBlockSerializer<S>) {
+        serializer.writeNative(bytes);
+      } else {
+        for (auto byte : bytes) {
+          serialize(serializer, std::to_integer<uint8_t>(byte));
+        }
+      }
+    }
+
+    /**
+     * Packs the given number of bits into bytes (starting at the least significant bit of the first byte). The bits are
+     * read one by one from the iterator and assembled into 64-bit words before being split into bytes.
+     */
+    template <typename Iterator> constexpr void packBits(Iterator bits, std::size_t numBits, std::byte* out) {
+      for (std::size_t offset = 0; offset < numBits; offset += 64) {
+        auto wordBits = std::min<std::size_t>(numBits - offset, 64);
+        uint64_t word = 0;
+        for (std::size_t i = 0; i < wordBits; ++i, ++bits) {
+          word |= static_cast<uint64_t>(static_cast<bool>(*bits)) << i;
+        }
+        for (std::size_t i = 0; i < (wordBits + 7) / 8; ++i) {
+          *out++ = static_cast<std::byte>(word >> (8 * i));
+        }
+      }
+    }
+  } // namespace detail
 
   // Common standard library types
 
-  template <Serializer S, typename T> void serialize(S& serializer, const std::atomic<T>& atomic) {
+  template <Serializer S, typename T> constexpr void serialize(S& serializer, const std::atomic<T>& atomic) {
     serialize(serializer, atomic.load());
   }
 
   template <Serializer S, typename R, typename P>
-  void serialize(S& serializer, const std::chrono::duration<R, P>& duration) {
+  constexpr void serialize(S& serializer, const std::chrono::duration<R, P>& duration) {
     serialize(serializer, duration.count());
   }
 
   template <Serializer S, typename C, typename D>
-  void serialize(S& serializer, const std::chrono::time_point<C, D>& time) {
+  constexpr void serialize(S& serializer, const std::chrono::time_point<C, D>& time) {
     serialize(serializer, time.time_since_epoch().count());
   }
 
-  template <Serializer S, typename T> void serialize(S& serializer, const std::complex<T>& complex) {
+  template <Serializer S, typename T> constexpr void serialize(S& serializer, const std::complex<T>& complex) {
     serialize(serializer, complex.real());
     serialize(serializer, complex.imag());
   }
 
-  template <Serializer S, typename T> void serialize(S& serializer, const std::optional<T>& option) {
+  template <Serializer S, typename T> constexpr void serialize(S& serializer, const std::optional<T>& option) {
     serialize(serializer, option.has_value());
     if (option) {
       serialize(serializer, option.value());
@@ -128,12 +188,12 @@ namespace serialize {
    * Serialize for sized iterable containers containing trivial types (e.g. std::array, std::string, std::vector with
    * integral elements) via a ByteSerializer by using the more efficient raw memory serialization function.
    */
-  template <ByteSerializer S, SerializableRawData C> void serialize(S& serializer, const C& container) {
+  template <ByteSerializer S, SerializableRawData C> constexpr void serialize(S& serializer, const C& container) {
     serializer.write(std::ranges::size(container),
                      std::as_bytes(std::span<const std::ranges::range_value_t<C>>{container}));
   }
 
-  template <Serializer S, SerializableRawData C> void serialize(S& serializer, const C& container) {
+  template <Serializer S, SerializableRawData C> constexpr void serialize(S& serializer, const C& container) {
     serialize(serializer, std::ranges::size(container));
     for (const auto& entry : container) {
       serialize(serializer, entry);
@@ -151,7 +211,7 @@ namespace serialize {
    * Serialize any other sized iterable containers (e.g. std::array, std::map, std::set std::string, std::unordered_set,
    * std::vector).
    */
-  template <Serializer S, SerializableContainer C> void serialize(S& serializer, const C& container) {
+  template <Serializer S, SerializableContainer C> constexpr void serialize(S& serializer, const C& container) {
     serialize(serializer, std::ranges::size(container));
     for (const auto& entry : container) {
       serialize(serializer, entry);
@@ -161,42 +221,56 @@ namespace serialize {
   /**
    * Serialize any tuple-like types (e.g. std::tuple, std::pair).
    */
-  template <Serializer S, detail::TupleType T> void serialize(S& serializer, const T& tuple) {
+  template <Serializer S, detail::TupleType T> constexpr void serialize(S& serializer, const T& tuple) {
     std::apply([&serializer](const auto&... args) { (serialize(serializer, args), ...); }, tuple);
   }
 
-  template <Serializer S, typename T> void serialize(S& serializer, const std::unique_ptr<T>& ptr) {
+  template <Serializer S, typename T> constexpr void serialize(S& serializer, const std::unique_ptr<T>& ptr) {
     serialize(serializer, static_cast<bool>(ptr));
     if (ptr) {
       serialize(serializer, *ptr);
     }
   }
 
-  template <Serializer S, typename... Args> void serialize(S& serializer, const std::variant<Args...>& variant) {
+  template <Serializer S, typename... Args>
+  constexpr void serialize(S& serializer, const std::variant<Args...>& variant) {
     serialize(serializer, variant.index());
     std::visit([&serializer](const auto& obj) { serialize(serializer, obj); }, variant);
   }
 
-  template <Serializer S, std::size_t N> void serialize(S& serializer, const std::bitset<N>& bits) {
+  template <Serializer S, std::size_t N> constexpr void serialize(S& serializer, const std::bitset<N>& bits) {
     if constexpr (!std::is_same_v<detail::EnclosingUnsignedType<N>, void>) {
       // can store as integral
       serialize(serializer, static_cast<detail::EnclosingUnsignedType<N>>(bits.to_ullong()));
+    } else if constexpr (detail::hasPackedBitsetLayout<N>()) {
+      // the object representation already is the chunks of bits written below
+      detail::writePackedBytes(serializer, std::span{reinterpret_cast<const std::byte*>(&bits), (N + 7) / 8});
     } else {
       // need to store as chunks of bits
       uint8_t tmp = 0;
       for (std::size_t i = 0; i < N; ++i) {
-        if (i > 0 && i % 8 == 0) {
+        tmp |= (bits.test(i) ? 1 : 0) << (i % 8);
+        if (i % 8 == 7 || i + 1 == N) {
           serialize(serializer, tmp);
           tmp = 0;
         }
-        tmp |= (bits.test(i) ? 1 : 0) << (i % 8);
-      }
-      if (N % 8) {
-        serialize(serializer, tmp);
       }
     }
   }
 
+  /**
+   * Serialize a std::vector<bool> as its size followed by the packed bits (8 bits per uint8_t value).
+   */
+  template <Serializer S, typename Alloc> void serialize(S& serializer, const std::vector<bool, Alloc>& bits) {
+    serialize(serializer, bits.size());
+    std::array<std::byte, detail::PACKED_BITS_CHUNK_SIZE> chunk;
+    for (std::size_t offset = 0; offset < bits.size(); offset += chunk.size() * 8) {
+      auto numBits = std::min(bits.size() - offset, chunk.size() * 8);
+      detail::packBits(bits.begin() + static_cast<std::ptrdiff_t>(offset), numBits, chunk.data());
+      detail::writePackedBytes(serializer, std::span{chunk}.first((numBits + 7) / 8));
+    }
+  }
+
   namespace detail {
     template <Serializer S, typename T>
     constexpr bool is_member_serializable = requires(const T obj, S serializer) { obj.serialize(serializer); };
@@ -216,7 +290,7 @@ namespace serialize {
    * Serialize any type with member serialize() function.
    */
   template <Serializer S, typename T>
-  std::enable_if_t<detail::is_member_serializable<S, T>> serialize(S& serializer, const T& object) {
+  constexpr std::enable_if_t<detail::is_member_serializable<S, T>> serialize(S& serializer, const T& object) {
     object.serialize(serializer);
   }
 
@@ -224,7 +298,7 @@ namespace serialize {
    * Serialize any type with static member serialize() function.
    */
   template <Serializer S, typename T>
-  std::enable_if_t<detail::is_static_member_serializable<S, T>> serialize(S& serializer, const T& object) {
+  constexpr std::enable_if_t<detail::is_static_member_serializable<S, T>> serialize(S& serializer, const T& object) {
     T::serialize(serializer, object);
   }
 
@@ -232,7 +306,8 @@ namespace serialize {
    * Serialize "any" other standard layout type via structured binding to the members.
    */
   template <Serializer S, typename T>
-  std::enable_if_t<detail::is_structured_bindings_serializable<S, T>> serialize(S& serializer, const T& object) {
+  constexpr std::enable_if_t<detail::is_structured_bindings_serializable<S, T>> serialize(S& serializer,
+                                                                                         const T& object) {
     detail::forEachMember(object, [&serializer](auto member) { serialize(serializer, member); });
   }
 } // namespace serialize
@@ -10,6 +10,7 @@
 #include "deserialize.hpp"
 #include "serialize.hpp"
 
+#include <climits>
 #include <iostream>
 
 namespace serialize {
@@ -30,8 +31,24 @@ namespace serialize {
       out.write(reinterpret_cast<const char*>(data.data()), data.size());
     }
 
+    /**
+     * Writes the given bytes as-is, e.g. the concatenated native representation of multiple values.
+     */
+    void writeNative(std::span<const std::byte> data) {
+      out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    void splice(SimpleStreamSerializer&& /* other */, std::span<const std::byte> data) {
+      out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
     void flush() {}
 
+    /**
+     * Returns the maximum number of bits written for a single value of the given fundamental type.
+     */
+    template <typename T> static constexpr std::size_t maxEncodedBits() noexcept { return sizeof(T) * CHAR_BIT; }
+
   private:
     std::ostream& out;
   };
@@ -49,7 +66,31 @@ namespace serialize {
       }
     }
 
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>, bool> tryRead(T& val) {
+      // only read if the whole value can be read without blocking
+      if (in.rdbuf()->in_avail() < static_cast<std::streamsize>(sizeof(T))) {
+        return false;
+      }
+      read(val);
+      return true;
+    }
+
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues) {
+      skipBytes(numValues * sizeof(T));
+    }
+
+    /**
+     * Reads the native representation of multiple values into the given bytes as-is.
+     */
+    void readNative(std::span<std::byte> data) {
+      if (!in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        detail::throwOnEof();
+      }
+    }
+
   private:
+    void skipBytes(std::size_t numBytes);
+
     std::istream& in;
   };
 
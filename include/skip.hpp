@@ -0,0 +1,227 @@
+/*
+ * Skipping of serialized values without materializing them.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * Extension of the Deserializer allowing to move past fundamental values without reading them.
+   */
+  template <typename T>
+  concept SkippingDeserializer = Deserializer<T> && requires(T obj) {
+    /**
+     * Prototype for a function skipping the given number of consecutive values of the fundamental template type.
+     */
+    obj.template skip<uint32_t>(std::declval<std::size_t>());
+  };
+
+  namespace detail {
+    template <typename T>
+    constexpr bool is_skippable_fundamental_v = std::is_fundamental_v<T> || std::is_same_v<T, std::byte>;
+
+    /**
+     * Skips the given number of consecutive fundamental values, using the more efficient Deserializer function if
+     * available.
+     */
+    template <typename T, Deserializer D> void skipValues(D& deserializer, std::size_t numValues) {
+      if constexpr (std::is_same_v<T, std::byte>) {
+        skipValues<uint8_t>(deserializer, numValues);
+      } else if constexpr (SkippingDeserializer<D>) {
+        deserializer.template skip<T>(numValues);
+      } else {
+        T tmp{};
+        for (std::size_t i = 0; i < numValues; ++i) {
+          deserializer.read(tmp);
+        }
+      }
+    }
+
+    /**
+     * Skips the given number of consecutive container elements.
+     */
+    template <typename T, Deserializer D> void skipElements(D& deserializer, std::size_t numElements);
+
+    /**
+     * Helper type for basic skipping, directly skipping fundamental values or falling back to deserializing (and
+     * dropping) the value for all other types.
+     */
+    template <typename T> struct BasicSkipCall {
+      template <Deserializer D> void operator()(D& deserializer) const {
+        if constexpr (is_skippable_fundamental_v<std::remove_const_t<T>>) {
+          skipValues<std::remove_const_t<T>>(deserializer, 1);
+        } else {
+          std::ignore = deserialize<T>(deserializer);
+        }
+      }
+    };
+  } // namespace detail
+
+  /**
+   * Main skipping function.
+   *
+   * Moves the given deserializer past a value of the template type parameter without materializing it, i.e. without
+   * allocating memory for strings or containers.
+   *
+   * The generic overload supports all fundamental types and falls back to deserializing and dropping the value for any
+   * type whose serialized layout is not known (e.g. types with custom deserialize() functions).
+   */
+  template <typename T> static constexpr detail::BasicSkipCall<T> skip;
+
+  // Common standard library types
+
+  template <typename T>
+  static constexpr auto skip<std::atomic<T>> = [](Deserializer auto& deserializer) { skip<T>(deserializer); };
+
+  template <typename R, typename P>
+  static constexpr auto skip<std::chrono::duration<R, P>> = [](Deserializer auto& deserializer) {
+    skip<R>(deserializer);
+  };
+
+  template <typename C, typename Dur>
+  static constexpr auto skip<std::chrono::time_point<C, Dur>> = [](Deserializer auto& deserializer) {
+    skip<Dur>(deserializer);
+  };
+
+  template <typename T>
+  static constexpr auto skip<std::complex<T>> = [](Deserializer auto& deserializer) {
+    detail::skipValues<T>(deserializer, 2);
+  };
+
+  template <typename T>
+  static constexpr auto skip<std::optional<T>> = [](Deserializer auto& deserializer) {
+    if (deserialize<bool>(deserializer)) {
+      skip<T>(deserializer);
+    }
+  };
+
+  template <typename T, std::size_t N>
+  static constexpr auto skip<std::array<T, N>> = [](Deserializer auto& deserializer) {
+    detail::skipElements<std::remove_cv_t<T>>(deserializer, deserialize<std::size_t>(deserializer));
+  };
+
+  /**
+   * Skip any growable container (e.g. std::map, std::set std::string, std::unordered_set, std::vector, std::list).
+   *
+   * Containers of fundamental types are skipped in a single call to the Deserializer.
+   */
+  template <DeserializableGrowableContainer C>
+  static constexpr auto skip<C> = [](Deserializer auto& deserializer) {
+    using ValueType = std::remove_cv_t<std::ranges::range_value_t<C>>;
+    using SizeType = decltype(std::ranges::size(std::declval<C>()));
+    detail::skipElements<ValueType>(deserializer, deserialize<SizeType>(deserializer));
+  };
+
+  /**
+   * Skip a std::string, still passing it to deserializers reading the strings themselves, e.g. to keep their state.
+   */
+  template <>
+  inline constexpr auto skip<std::string> = [](Deserializer auto& deserializer) {
+    if constexpr (StringDeserializer<std::remove_reference_t<decltype(deserializer)>>) {
+      std::ignore = deserializer.readString();
+    } else {
+      detail::skipElements<char>(deserializer, deserialize<std::size_t>(deserializer));
+    }
+  };
+
+  template <typename... Args>
+  static constexpr auto skip<std::tuple<Args...>> = [](Deserializer auto& deserializer) {
+    (skip<std::remove_cv_t<Args>>(deserializer), ...);
+  };
+
+  template <typename F, typename S>
+  static constexpr auto skip<std::pair<F, S>> = [](Deserializer auto& deserializer) {
+    skip<std::remove_cv_t<F>>(deserializer);
+    skip<std::remove_cv_t<S>>(deserializer);
+  };
+
+  template <typename T>
+  static constexpr auto skip<std::unique_ptr<T>> = [](Deserializer auto& deserializer) {
+    if (deserialize<bool>(deserializer)) {
+      skip<T>(deserializer);
+    }
+  };
+
+  // shared objects are read by the deserializer itself, e.g. to still register them for resolving later references
+  template <typename T> static constexpr detail::BasicSkipCall<std::shared_ptr<T>> skip<std::shared_ptr<T>>;
+  template <typename T> static constexpr detail::BasicSkipCall<std::weak_ptr<T>> skip<std::weak_ptr<T>>;
+
+  template <typename... Args>
+  static constexpr auto skip<std::variant<Args...>> = [](Deserializer auto& deserializer) {
+    auto index = deserialize<std::size_t>(deserializer);
+    if (index == std::variant_npos) {
+      throw std::runtime_error{"Cannot skip valueless_by_exception variant object"};
+    }
+    [&deserializer, index]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+      auto skipIndex = [&deserializer, index]<typename T, std::size_t Index>() {
+        if (index == Index) {
+          skip<T>(deserializer);
+        }
+      };
+      (skipIndex.template operator()<Args, Indices>(), ...);
+    }(std::index_sequence_for<Args...>{});
+  };
+
+  template <std::size_t N>
+  static constexpr auto skip<std::bitset<N>> = [](Deserializer auto& deserializer) {
+    if constexpr (!std::is_same_v<detail::EnclosingUnsignedType<N>, void>) {
+      detail::skipValues<detail::EnclosingUnsignedType<N>>(deserializer, 1);
+    } else {
+      detail::skipValues<uint8_t>(deserializer, (N + 7) / 8);
+    }
+  };
+
+  template <typename Alloc>
+  static constexpr auto skip<std::vector<bool, Alloc>> = [](Deserializer auto& deserializer) {
+    detail::skipValues<uint8_t>(deserializer, (deserialize<std::size_t>(deserializer) + 7) / 8);
+  };
+
+  /**
+   * Skip "any" other standard layout type via structured binding to the members.
+   *
+   * NOTE: The current implementation requires a default-constructible type!
+   */
+  template <detail::StructuredBindingDeserializable T>
+  static constexpr auto skip<T> = [](Deserializer auto& deserializer) {
+    // only used to determine the member types, default-constructing (empty) members does not allocate
+    std::remove_reference_t<T> tmp{};
+    detail::forEachMember(
+        tmp, [&deserializer](auto& member) { skip<std::remove_cvref_t<decltype(member)>>(deserializer); });
+  };
+
+  namespace detail {
+    template <typename T, Deserializer D> void skipElements(D& deserializer, std::size_t numElements) {
+      if constexpr (is_skippable_fundamental_v<T>) {
+        skipValues<T>(deserializer, numElements);
+      } else {
+        for (std::size_t i = 0; i < numElements; ++i) {
+          skip<T>(deserializer);
+        }
+      }
+    }
+  } // namespace detail
+} // namespace serialize
@@ -0,0 +1,92 @@
+/*
+ * In-memory standard stream implementations.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <streambuf>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    class BufferStreamBuffer : public std::streambuf {
+    public:
+      std::span<const std::byte> data() const noexcept {
+        return std::as_bytes(std::span<const char>{pbase(), static_cast<std::size_t>(pptr() - pbase())});
+      }
+
+      void reset() noexcept { setp(storage.data(), storage.data() + storage.size()); }
+
+    protected:
+      int_type overflow(int_type ch) override;
+      std::streamsize xsputn(const char_type* s, std::streamsize count) override;
+
+    private:
+      void grow(std::size_t minCapacity);
+      void advance(std::size_t numBytes);
+
+      std::vector<char> storage;
+    };
+
+    class SpanStreamBuffer : public std::streambuf {
+    public:
+      explicit SpanStreamBuffer(std::span<const std::byte> data) { reset(data); }
+
+      void reset(std::span<const std::byte> data) noexcept;
+
+    protected:
+      pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+      pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+    };
+  } // namespace detail
+
+  /**
+   * Output stream writing into a growable in-memory byte buffer.
+   *
+   * The buffer can be reused (without releasing the allocated memory) via #reset().
+   */
+  class BufferOutputStream : private detail::BufferStreamBuffer, public std::ostream {
+  public:
+    BufferOutputStream() : std::ostream(static_cast<detail::BufferStreamBuffer*>(this)) {}
+
+    /**
+     * Returns the data written since construction or the last call to #reset().
+     */
+    std::span<const std::byte> data() const noexcept { return detail::BufferStreamBuffer::data(); }
+
+    void reset() noexcept {
+      detail::BufferStreamBuffer::reset();
+      clear();
+    }
+  };
+
+  /**
+   * Input stream reading from a non-owning in-memory byte buffer.
+   */
+  class SpanInputStream : private detail::SpanStreamBuffer, public std::istream {
+  public:
+    explicit SpanInputStream(std::span<const std::byte> data)
+        : detail::SpanStreamBuffer(data), std::istream(static_cast<detail::SpanStreamBuffer*>(this)) {}
+
+    /**
+     * Returns the number of bytes already read from the buffer.
+     */
+    std::size_t position() const noexcept { return static_cast<std::size_t>(gptr() - eback()); }
+
+    /**
+     * Switches to reading from the given buffer and clears the stream state.
+     */
+    void reset(std::span<const std::byte> data) noexcept {
+      detail::SpanStreamBuffer::reset(data);
+      clear();
+    }
+  };
+
+} // namespace serialize
@@ -0,0 +1,257 @@
+/*
+ * Tagged record streams writing every member with its field number and size for evolvable schemas.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include "common.hpp"
+#include "deserialize.hpp"
+#include "framed.hpp"
+#include "serialize.hpp"
+#include "streams.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * Concept for aggregate types providing explicit field numbers for their members via a static member:
+   *
+   *     static constexpr std::array<uint32_t, <number of members>> fieldNumbers{...};
+   *
+   * Field numbers need to be unique within the type and should never be reused for different members, even after the
+   * original member has been removed.
+   */
+  template <typename T>
+  concept ExplicitlyTaggedRecord = detail::ReflectableAggregate<T> && requires {
+    { T::fieldNumbers } -> std::convertible_to<std::array<uint32_t, detail::memberCount<T>>>;
+  };
+
+  /**
+   * Concept for aggregate types which can be written as tagged record, either with explicit field numbers (see
+   * ExplicitlyTaggedRecord) or with the member positions (starting at 1) as field numbers.
+   */
+  template <typename T>
+  concept TaggedRecord = detail::ReflectableAggregate<T> && std::default_initializable<T>;
+
+  namespace detail {
+    template <TaggedRecord T> consteval std::array<uint32_t, memberCount<T>> taggedFieldNumbers() {
+      if constexpr (ExplicitlyTaggedRecord<T>) {
+        return T::fieldNumbers;
+      } else {
+        std::array<uint32_t, memberCount<T>> numbers{};
+        for (std::size_t i = 0; i < numbers.size(); ++i) {
+          numbers[i] = static_cast<uint32_t>(i + 1);
+        }
+        return numbers;
+      }
+    }
+
+    template <std::size_t N> consteval bool hasUniqueFieldNumbers(const std::array<uint32_t, N>& numbers) {
+      for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t k = i + 1; k < N; ++k) {
+          if (numbers[i] == numbers[k]) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    struct TaggedField {
+      uint32_t number;
+      std::span<const std::byte> value;
+    };
+
+    /**
+     * Writes the field header (the field number and the value size in bytes) followed by the value.
+     */
+    void writeTaggedField(std::ostream& out, uint32_t number, std::span<const std::byte> value);
+
+    /**
+     * Splits the next field off the front of the given record data.
+     *
+     * Malformed data is reported by throwing a std::domain_error.
+     */
+    TaggedField nextTaggedField(std::span<const std::byte>& data);
+
+    /**
+     * Writes the fields of tagged records into reusable buffers, one per nesting level.
+     */
+    template <Serializer S>
+      requires(std::constructible_from<S, std::ostream&>)
+    class TaggedFieldsWriter {
+    public:
+      template <TaggedRecord T> std::span<const std::byte> write(const T& record) { return writeFields(record, 0); }
+
+    private:
+      template <TaggedRecord T> std::span<const std::byte> writeFields(const T& record, std::size_t level) {
+        static constexpr auto numbers = taggedFieldNumbers<T>();
+        static_assert(hasUniqueFieldNumbers(numbers), "Field numbers of tagged records need to be unique");
+        auto& fields = buffer(level);
+        fields.reset();
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          (writeTaggedField(fields, numbers[Indices], writeValue(memberAt<Indices>(record), level + 1)), ...);
+        }(std::make_index_sequence<memberCount<T>>{});
+        return fields.data();
+      }
+
+      template <typename T> std::span<const std::byte> writeValue(const T& value, std::size_t level) {
+        if constexpr (ExplicitlyTaggedRecord<T> && TaggedRecord<T>) {
+          // nested records are tagged too, if explicitly opted in
+          return writeFields(value, level);
+        } else {
+          auto& out = buffer(level);
+          out.reset();
+          S serializer{out};
+          serialize(serializer, value);
+          serializer.flush();
+          return out.data();
+        }
+      }
+
+      BufferOutputStream& buffer(std::size_t level) {
+        while (buffers.size() <= level) {
+          buffers.emplace_back(std::make_unique<BufferOutputStream>());
+        }
+        return *buffers[level];
+      }
+
+      std::vector<std::unique_ptr<BufferOutputStream>> buffers;
+    };
+
+    template <Deserializer D, typename T>
+      requires(std::constructible_from<D, std::istream&>)
+    void readTaggedValue(std::span<const std::byte> data, T& value);
+
+    template <Deserializer D, TaggedRecord T>
+      requires(std::constructible_from<D, std::istream&>)
+    void readTaggedFields(std::span<const std::byte> data, T& record) {
+      static constexpr auto numbers = taggedFieldNumbers<T>();
+      while (!data.empty()) {
+        auto field = nextTaggedField(data);
+        // unknown fields (e.g. of removed members) are skipped without looking at their contents
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+          ((field.number == numbers[Indices] ? (readTaggedValue<D>(field.value, memberAt<Indices>(record)), true)
+                                             : false) ||
+           ...);
+        }(std::make_index_sequence<memberCount<T>>{});
+      }
+    }
+
+    template <Deserializer D, typename T>
+      requires(std::constructible_from<D, std::istream&>)
+    void readTaggedValue(std::span<const std::byte> data, T& value) {
+      if constexpr (ExplicitlyTaggedRecord<T> && TaggedRecord<T>) {
+        readTaggedFields<D>(data, value);
+      } else {
+        SpanInputStream in{data};
+        D deserializer{in};
+        deserializeInto(deserializer, value);
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Writer for aggregate types writing every member as separate field, prefixed with its field number and its
+   * serialized size in bytes, and every record prefixed with its size in bytes.
+   *
+   * This allows readers to skip unknown (e.g. added) members in constant time and to keep the default values for
+   * missing (e.g. removed) members, i.e. to read data written with other versions of the same type.
+   *
+   * The field numbers are the positions of the members (starting at 1) or given explicitly via the static
+   * `fieldNumbers` member (see ExplicitlyTaggedRecord). Members of aggregate types with explicit field numbers are
+   * again written as tagged records, all other member values are written with the wrapped Serializer type.
+   */
+  template <Serializer S>
+    requires(std::constructible_from<S, std::ostream&>)
+  class TaggedRecordWriter {
+  public:
+    explicit TaggedRecordWriter(std::ostream& os) : out(os) {}
+
+    template <TaggedRecord T> void write(const T& record) { detail::writeFrame(out, fields.write(record)); }
+
+    void flush() { out.flush(); }
+
+  private:
+    std::ostream& out;
+    detail::TaggedFieldsWriter<S> fields;
+  };
+
+  /**
+   * Reader for the records written by the TaggedRecordWriter.
+   *
+   * Members without a field in the read data keep their current (e.g. default) value, fields without a matching member
+   * are skipped. Malformed data and records larger than the given maximum frame size are reported by throwing a
+   * std::domain_error.
+   */
+  template <Deserializer D>
+    requires(std::constructible_from<D, std::istream&>)
+  class TaggedRecordReader {
+  public:
+    explicit TaggedRecordReader(std::istream& is, std::size_t maxFrameSize = DEFAULT_MAX_FRAME_SIZE)
+        : in(is), maxFrameSize(maxFrameSize) {}
+
+    /**
+     * Reads the next record into the given object, returns whether a record was read before reaching the end of the
+     * stream.
+     *
+     * NOTE: Members without matching field in the record keep their current value, i.e. reusing the same object for
+     * multiple records carries over the values of the previous record. Use #read() to start every record from
+     * default-initialized members.
+     */
+    template <TaggedRecord T> bool readInto(T& record) {
+      auto size = detail::readFrameSize(in);
+      if (!size) {
+        return false;
+      }
+      detail::readFramePayload(in, *size, maxFrameSize, payload);
+      detail::readTaggedFields<D>(payload, record);
+      return true;
+    }
+
+    /**
+     * Reads the next record into a default-constructed object, returns an empty value at the end of the stream.
+     */
+    template <TaggedRecord T> std::optional<T> read() {
+      T record{};
+      if (!readInto(record)) {
+        return {};
+      }
+      return record;
+    }
+
+    /**
+     * Skips the given number of records without reading their fields, returns the number of records actually skipped.
+     */
+    std::size_t skip(std::size_t numRecords = 1) {
+      std::size_t numSkipped = 0;
+      for (; numSkipped < numRecords; ++numSkipped) {
+        auto size = detail::readFrameSize(in);
+        if (!size) {
+          break;
+        }
+        detail::skipFramePayload(in, *size);
+      }
+      return numSkipped;
+    }
+
+  private:
+    std::istream& in;
+    std::size_t maxFrameSize;
+    std::vector<std::byte> payload;
+  };
+
+} // namespace serialize
@@ -0,0 +1,109 @@
+/*
+ * Work-stealing thread pool used for parallel (de-)serialization.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace serialize {
+
+  /**
+   * Fixed-size thread pool where each worker thread has its own task queue.
+   *
+   * Tasks submitted from outside of the pool are distributed round-robin across the workers, tasks submitted from a
+   * worker thread are queued in that worker's queue. Each worker processes its own queue in submission order and steals
+   * the most recently queued tasks from other workers once its own queue runs empty.
+   *
+   * NOTE: Tasks must not throw exceptions, any exception escaping a task terminates the program!
+   */
+  class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(std::size_t numThreads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) noexcept = delete;
+    /**
+     * Waits for all queued tasks to be processed and stops the worker threads.
+     */
+    ~ThreadPool() noexcept;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+    void submit(Task&& task);
+
+    std::size_t size() const noexcept { return threads.size(); }
+
+  private:
+    struct Worker {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    void run(std::size_t index);
+    bool tryPop(std::size_t index, Task& task);
+    bool trySteal(std::size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic_size_t nextWorker;
+    std::atomic_size_t numQueued;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+  };
+
+  namespace detail {
+    /**
+     * Appends the given work item (with "error" and "done" members) to the in-flight items and submits a task running
+     * the given function for it to the pool. The task stores any exception thrown by the function in the item and marks
+     * it as done with the mutex held, notifying the condition variable.
+     *
+     * If submitting the task fails, the item is removed from the in-flight items again and moved back into the given
+     * pointer, since it would never be marked as done.
+     */
+    template <typename Item, typename Func>
+    void submitInFlight(ThreadPool& pool, std::deque<std::unique_ptr<Item>>& inFlight, std::unique_ptr<Item>& item,
+                        std::mutex& mutex, std::condition_variable& condition, Func&& func) {
+      auto* itemPtr = item.get();
+      {
+        std::lock_guard guard{mutex};
+        inFlight.emplace_back(std::move(item));
+      }
+      try {
+        pool.submit([itemPtr, &mutex, &condition, func = std::forward<Func>(func)]() mutable {
+          try {
+            func(*itemPtr);
+          } catch (...) {
+            itemPtr->error = std::current_exception();
+          }
+          // notify with the lock held, since the waiting thread might destroy the condition variable right after
+          std::lock_guard guard{mutex};
+          itemPtr->done = true;
+          condition.notify_all();
+        });
+      } catch (...) {
+        std::lock_guard guard{mutex};
+        item = std::move(inFlight.back());
+        inFlight.pop_back();
+        throw;
+      }
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -9,6 +9,7 @@
 
 #include "deserialize.hpp"
 #include "serialize.hpp"
+#include "skip.hpp"
 
 #include <memory>
 #include <stdexcept>
@@ -97,6 +98,18 @@ namespace serialize {
       inner.read(val);
     }
 
+    template <typename T> std::enable_if_t<std::is_fundamental_v<T>> skip(std::size_t numValues) {
+      // every value is preceded by its own type-id, so we need to check them one by one
+      for (std::size_t i = 0; i < numValues; ++i) {
+        uint8_t typeId = 255;
+        inner.read(typeId);
+        if (typeId != detail::type_id_v<T>) {
+          detail::throwOnTypeMismatch(detail::type_id_v<T>, typeId);
+        }
+        detail::skipValues<T>(inner, 1);
+      }
+    }
+
   private:
     std::unique_ptr<Inner> innerHolder;
     Inner& inner;
@@ -0,0 +1,303 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "async_stream.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace serialize {
+
+  namespace detail {
+    static void writeToFile(int fileDescriptor, std::span<const std::byte> data) {
+      while (!data.empty()) {
+#ifdef _WIN32
+        auto chunkSize = static_cast<unsigned>(std::min<std::size_t>(data.size(), std::numeric_limits<int>::max()));
+        auto numWritten = _write(fileDescriptor, data.data(), chunkSize);
+#else
+        auto numWritten = ::write(fileDescriptor, data.data(), data.size());
+#endif
+        if (numWritten < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          throw std::system_error{errno, std::generic_category(), "Failed to write to file"};
+        }
+        data = data.subspan(static_cast<std::size_t>(numWritten));
+      }
+    }
+
+    static void syncFile(int fileDescriptor) {
+#ifdef _WIN32
+      auto result = _commit(fileDescriptor);
+#elif defined(__linux__)
+      auto result = ::fdatasync(fileDescriptor);
+#else
+      auto result = ::fsync(fileDescriptor);
+#endif
+      if (result != 0) {
+        throw std::system_error{errno, std::generic_category(), "Failed to synchronize file"};
+      }
+    }
+
+    static std::size_t readFromFile(int fileDescriptor, std::span<std::byte> data) {
+      while (true) {
+#ifdef _WIN32
+        auto chunkSize = static_cast<unsigned>(std::min<std::size_t>(data.size(), std::numeric_limits<int>::max()));
+        auto numRead = _read(fileDescriptor, data.data(), chunkSize);
+#else
+        auto numRead = ::read(fileDescriptor, data.data(), data.size());
+#endif
+        if (numRead < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          throw std::system_error{errno, std::generic_category(), "Failed to read from file"};
+        }
+        return static_cast<std::size_t>(numRead);
+      }
+    }
+
+    AsyncWriteBuffer::AsyncWriteBuffer(WriteData&& writeData, SyncData&& syncData, std::size_t bufferSize,
+                                       std::size_t numBuffers)
+        : writeData(std::move(writeData)), syncData(std::move(syncData)), currentBuffer(0), numSubmitted(0),
+          numCompleted(0), stopping(false) {
+      bufferSize = std::max(bufferSize, std::size_t{1});
+      // need at least one buffer to write into while the other one is drained
+      numBuffers = std::max(numBuffers, std::size_t{2});
+      buffers.resize(numBuffers, std::vector<char>(bufferSize));
+      for (std::size_t i = 1; i < numBuffers; ++i) {
+        freeBuffers.push_back(i);
+      }
+      setp(buffers[currentBuffer].data(), buffers[currentBuffer].data() + bufferSize);
+      worker = std::thread{&AsyncWriteBuffer::run, this};
+    }
+
+    AsyncWriteBuffer::~AsyncWriteBuffer() noexcept {
+      sync();
+      {
+        std::lock_guard guard{mutex};
+        stopping = true;
+      }
+      condition.notify_all();
+      worker.join();
+    }
+
+    AsyncWriteBuffer::int_type AsyncWriteBuffer::overflow(int_type ch) {
+      submit(false);
+      std::unique_lock lock{mutex};
+      acquireBuffer(lock);
+      if (error) {
+        // report the error only once
+        std::rethrow_exception(std::exchange(error, nullptr));
+      }
+      lock.unlock();
+      if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    int AsyncWriteBuffer::sync() {
+      submit(true);
+      std::unique_lock lock{mutex};
+      acquireBuffer(lock);
+      waitForCompletion(lock);
+      return std::exchange(error, nullptr) ? -1 : 0;
+    }
+
+    void AsyncWriteBuffer::submit(bool sync) {
+      auto size = static_cast<std::size_t>(pptr() - pbase());
+      {
+        std::lock_guard guard{mutex};
+        jobs.push_back(Job{currentBuffer, size, sync});
+        ++numSubmitted;
+      }
+      condition.notify_all();
+      // no buffer to write into until the next one is acquired
+      setp(nullptr, nullptr);
+    }
+
+    void AsyncWriteBuffer::acquireBuffer(std::unique_lock<std::mutex>& lock) {
+      condition.wait(lock, [this]() { return !freeBuffers.empty(); });
+      currentBuffer = freeBuffers.back();
+      freeBuffers.pop_back();
+      auto& buffer = buffers[currentBuffer];
+      setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    void AsyncWriteBuffer::waitForCompletion(std::unique_lock<std::mutex>& lock) {
+      auto target = numSubmitted;
+      condition.wait(lock, [this, target]() { return numCompleted >= target; });
+    }
+
+    void AsyncWriteBuffer::run() {
+      std::unique_lock lock{mutex};
+      while (true) {
+        condition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+          // stopping and all data written
+          return;
+        }
+        auto job = jobs.front();
+        jobs.pop_front();
+        lock.unlock();
+        std::exception_ptr jobError{};
+        try {
+          if (job.size) {
+            writeData(std::as_bytes(std::span{buffers[job.buffer]}.first(job.size)));
+          }
+          if (job.sync) {
+            syncData();
+          }
+        } catch (...) {
+          jobError = std::current_exception();
+        }
+        lock.lock();
+        if (jobError && !error) {
+          error = jobError;
+        }
+        freeBuffers.push_back(job.buffer);
+        ++numCompleted;
+        condition.notify_all();
+      }
+    }
+
+    AsyncReadBuffer::AsyncReadBuffer(ReadData&& readData, std::size_t bufferSize, std::size_t numBuffers)
+        : readData(std::move(readData)), currentBuffer(NO_BUFFER), endOfInput(false), stopping(false) {
+      bufferSize = std::max(bufferSize, std::size_t{1});
+      // need at least one buffer to read into while the other one is consumed
+      numBuffers = std::max(numBuffers, std::size_t{2});
+      buffers.resize(numBuffers, std::vector<char>(bufferSize));
+      for (std::size_t i = 0; i < numBuffers; ++i) {
+        freeBuffers.push_back(i);
+      }
+      setg(nullptr, nullptr, nullptr);
+      worker = std::thread{&AsyncReadBuffer::run, this};
+    }
+
+    AsyncReadBuffer::~AsyncReadBuffer() noexcept {
+      {
+        std::lock_guard guard{mutex};
+        stopping = true;
+      }
+      condition.notify_all();
+      worker.join();
+    }
+
+    AsyncReadBuffer::int_type AsyncReadBuffer::underflow() {
+      if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+      }
+      std::unique_lock lock{mutex};
+      if (currentBuffer != NO_BUFFER) {
+        // the current buffer is completely consumed, allow to read ahead into it
+        freeBuffers.push_back(std::exchange(currentBuffer, NO_BUFFER));
+        setg(nullptr, nullptr, nullptr);
+        condition.notify_all();
+      }
+      condition.wait(lock, [this]() { return endOfInput || !readyBlocks.empty(); });
+      if (readyBlocks.empty()) {
+        if (error) {
+          // report the error only once
+          std::rethrow_exception(std::exchange(error, nullptr));
+        }
+        return traits_type::eof();
+      }
+      auto block = readyBlocks.front();
+      readyBlocks.pop_front();
+      currentBuffer = block.buffer;
+      auto* start = buffers[block.buffer].data();
+      setg(start, start, start + block.size);
+      return traits_type::to_int_type(*gptr());
+    }
+
+    void AsyncReadBuffer::run() {
+      std::unique_lock lock{mutex};
+      while (true) {
+        condition.wait(lock, [this]() { return stopping || (!endOfInput && !freeBuffers.empty()); });
+        if (stopping) {
+          return;
+        }
+        auto buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+        lock.unlock();
+        std::size_t numRead = 0;
+        std::exception_ptr readError{};
+        try {
+          numRead = readData(std::as_writable_bytes(std::span{buffers[buffer]}));
+        } catch (...) {
+          readError = std::current_exception();
+        }
+        lock.lock();
+        if (numRead) {
+          readyBlocks.push_back(Block{buffer, numRead});
+        } else {
+          freeBuffers.push_back(buffer);
+          endOfInput = true;
+          error = readError;
+        }
+        condition.notify_all();
+      }
+    }
+  } // namespace detail
+
+  AsyncOutputStream::AsyncOutputStream(std::ostream& sink, std::size_t bufferSize, std::size_t numBuffers)
+      : detail::AsyncWriteBuffer(
+            [&sink](std::span<const std::byte> data) {
+              if (!sink.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+                throw std::ios_base::failure{"Failed to write to underlying stream"};
+              }
+            },
+            [&sink]() {
+              if (!sink.flush()) {
+                throw std::ios_base::failure{"Failed to flush underlying stream"};
+              }
+            },
+            bufferSize, numBuffers),
+        std::ostream(static_cast<detail::AsyncWriteBuffer*>(this)) {}
+
+  AsyncOutputStream::AsyncOutputStream(int fileDescriptor, std::size_t bufferSize, std::size_t numBuffers)
+      : detail::AsyncWriteBuffer([fileDescriptor](std::span<const std::byte> data) {
+          detail::writeToFile(fileDescriptor, data);
+        }, [fileDescriptor]() { detail::syncFile(fileDescriptor); }, bufferSize, numBuffers),
+        std::ostream(static_cast<detail::AsyncWriteBuffer*>(this)) {}
+
+  AsyncInputStream::AsyncInputStream(std::istream& source, std::size_t bufferSize, std::size_t numBuffers)
+      : detail::AsyncReadBuffer(
+            [&source](std::span<std::byte> data) {
+              source.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+              if (source.bad()) {
+                throw std::ios_base::failure{"Failed to read from underlying stream"};
+              }
+              return static_cast<std::size_t>(source.gcount());
+            },
+            bufferSize, numBuffers),
+        std::istream(static_cast<detail::AsyncReadBuffer*>(this)) {}
+
+  AsyncInputStream::AsyncInputStream(int fileDescriptor, std::size_t bufferSize, std::size_t numBuffers)
+      : detail::AsyncReadBuffer([fileDescriptor](std::span<std::byte> data) {
+          return detail::readFromFile(fileDescriptor, data);
+        }, bufferSize, numBuffers),
+        std::istream(static_cast<detail::AsyncReadBuffer*>(this)) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+    // only a hint to the kernel to increase its own read-ahead, so ignore any errors
+    ::posix_fadvise(fileDescriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  }
+
+} // namespace serialize
@@ -18,6 +18,9 @@ namespace serialize {
     uint8_t numBits = 0;
   };
 
+  /**
+   * NOTE: The code number (value + 1) for UINTMAX_MAX does not fit into the result, see #writeWideExpGolomb.
+   */
   constexpr BitValue encodeExpGolomb(uintmax_t value) noexcept {
     ++value;
     auto numBits = std::bit_width(value) - 1;
@@ -26,9 +29,14 @@ namespace serialize {
 
   constexpr uintmax_t decodeExpGolomb(uintmax_t value) noexcept { return value - 1U; }
 
+  /**
+   * NOTE: The mapped value (2 * |value|) for INTMAX_MIN does not fit into uintmax_t, see #writeWideExpGolomb.
+   */
   constexpr BitValue encodeSignedExpGolomb(intmax_t value) noexcept {
-    auto tmp = value < 0 ? (-2 * value) : value > 0 ? (2 * value - 1) : 0;
-    return encodeExpGolomb(std::bit_cast<uintmax_t>(tmp));
+    // calculate in unsigned arithmetic to not overflow for INTMAX_MAX
+    auto tmp = std::bit_cast<uintmax_t>(value);
+    tmp = value < 0 ? (0U - tmp) * 2U : value > 0 ? tmp * 2U - 1U : 0U;
+    return encodeExpGolomb(tmp);
   }
 
   constexpr intmax_t decodeSignedExpGolomb(uintmax_t value) noexcept {
@@ -87,6 +95,19 @@ namespace serialize {
     }
   }
 
+  /**
+   * The code numbers for UINTMAX_MAX (2^64) and INTMAX_MIN (2^64 + 1) are one bit wider than uintmax_t. Their codes
+   * consist of CACHE_SIZE leading zeroes, the marker 1-bit and the given lower CACHE_SIZE bits of the code number.
+   *
+   * Reading such a code via #readExGolombBits returns CACHE_SIZE + 1 bits with only the lower bits as value.
+   */
+  template <typename Func = void (*)(std::byte)>
+  static constexpr void writeWideExpGolomb(BitCache& cache, Func&& sinkByte, uintmax_t lowerBits) {
+    writeBits(cache, sinkByte, {0, CACHE_SIZE});
+    writeBits(cache, sinkByte, {1, 1});
+    writeBits(cache, sinkByte, {lowerBits, CACHE_SIZE});
+  }
+
   template <typename Func = bool (*)(std::byte&)>
   [[nodiscard]] static constexpr bool feedFullByte(BitCache& cache, Func&& sourceByte) {
     std::byte in{};
@@ -118,7 +139,8 @@ namespace serialize {
     cache.value <<= exponent;
     auto numBits = static_cast<uint8_t>(numLeadingZeroes + exponent + 1 /* marker 1-bit */);
 
-    // TODO due to limitation of output type, cannot read more the bits than fit into UINTMAX_T
+    // NOTE: Due to the limitation of the output type, only the lower bits of the wide codes (see #writeWideExpGolomb)
+    // with more than CACHE_SIZE bits are kept, i.e. their marker 1-bit is shifted out.
 
     // fill actual data bits
     BitValue result{};
@@ -128,7 +150,7 @@ namespace serialize {
       }
       if (cache.usedBits >= CACHE_SIZE / 2 && (numBits - result.numBits) > cache.usedBits) {
         // partially copy cache to result to not overflow when getting close to CACHE_SIZE bits
-        result.value |= cache.value >> (CACHE_SIZE - cache.usedBits);
+        result.value = (result.value << cache.usedBits) | (cache.value >> (CACHE_SIZE - cache.usedBits));
         result.numBits += cache.usedBits;
         cache.usedBits = 0;
         cache.value = 0;
@@ -148,6 +170,38 @@ namespace serialize {
     return result;
   }
 
+  template <typename Func = bool (*)(std::byte&)>
+  [[nodiscard]] static constexpr bool skipExGolombBits(BitCache& cache, Func&& sourceByte) {
+    uint32_t numLeadingZeroes = 0;
+    while (!cache.value) {
+      // See #readExGolombBits
+      numLeadingZeroes += cache.usedBits;
+      cache.usedBits = 0;
+      if (!feedFullByte(cache, sourceByte)) {
+        return false;
+      }
+    }
+
+    auto exponent = std::countl_zero(cache.value);
+    cache.usedBits -= exponent;
+    cache.value <<= exponent;
+    // marker 1-bit and as many data bits as there are leading zeroes
+    auto numBits = numLeadingZeroes + exponent + 1;
+
+    // drop whole cache contents until the remaining bits of the code are all in the cache
+    while (numBits > cache.usedBits) {
+      numBits -= cache.usedBits;
+      cache.usedBits = 0;
+      cache.value = 0;
+      if (!feedFullByte(cache, sourceByte)) {
+        return false;
+      }
+    }
+    cache.usedBits -= numBits;
+    cache.value = numBits == CACHE_SIZE ? 0 : (cache.value << numBits);
+    return true;
+  }
+
   static_assert(encodeExpGolomb(0U).value == 0b1);
   static_assert(encodeExpGolomb(0U).numBits == 1);
   static_assert(encodeExpGolomb(1U).value == 0b010);
@@ -294,6 +348,34 @@ namespace serialize {
       return {val.value, val.numBits, cache.value, cache.usedBits};
     }
 
+    static constexpr bool testSkipExpGolombBits(std::array<uint8_t, 16> input, uint8_t numCodes) {
+      // skipping needs to leave the cache in the same state as reading the codes
+      BitCache readCache;
+      BitCache skipCache;
+      uint8_t readIndex = 0;
+      uint8_t skipIndex = 0;
+      for (uint8_t i = 0; i < numCodes; ++i) {
+        auto value = readExGolombBits(readCache, [&](std::byte& out) {
+          if (readIndex < input.size()) {
+            out = std::bit_cast<std::byte>(input[readIndex++]);
+            return true;
+          }
+          return false;
+        });
+        auto status = skipExGolombBits(skipCache, [&](std::byte& out) {
+          if (skipIndex < input.size()) {
+            out = std::bit_cast<std::byte>(input[skipIndex++]);
+            return true;
+          }
+          return false;
+        });
+        if (status != (value.numBits != 0) || readCache != skipCache || readIndex != skipIndex) {
+          return false;
+        }
+      }
+      return true;
+    }
+
     // bit-cache is left-adjusted
     static_assert(testFlushFullBytes({0, 0}) == CacheResult{0, 0, 0, 0});
     static_assert(testFlushFullBytes({0, 17}) == CacheResult{0, 16, 0, 1});
@@ -353,5 +435,13 @@ namespace serialize {
                   CacheResult{0x123456789, 33, 0xA000000000000000, 7});
     static_assert(testReadExpGolombManyBits({0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x23, 0x45, 0x67, 0x89,
                                              0xAB, 0xCD, 0xEF, 0x00}) == CacheResult{0x91A2B3C4D5E6F780, 64, 0, 1});
+
+    // 0b1 | 0b010 | 0b011 | 0b00100 | ...
+    static_assert(testSkipExpGolombBits({0b10100110, 0b01000010, 0b01000000}, 5));
+    static_assert(testSkipExpGolombBits({0x00, 0x00, 0x00, 0x00, 0x91, 0xA2, 0xB3, 0xC4, 0xD0}, 2));
+    static_assert(testSkipExpGolombBits({0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB,
+                                         0xCD, 0xEF, 0x80},
+                                        2));
+    static_assert(testSkipExpGolombBits({0x00, 0x00, 0x00, 0x00}, 1));
   } // namespace detail
 } // namespace serialize
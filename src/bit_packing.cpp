@@ -7,15 +7,21 @@
 #include "bit_packing.hpp"
 
 #include "bit_helpers.hpp"
+#include "resumable.hpp"
+#include "skip.hpp"
 
 #include <array>
 #include <bit>
+#include <limits>
 
 namespace serialize {
 
   static_assert(Serializer<BitPackingSinkSerializer>);
   static_assert(!ByteSerializer<BitPackingSinkSerializer>);
+  static_assert(SplicingSerializer<BitPackingSinkSerializer>);
   static_assert(Deserializer<BitPackingSourceDeserializer>);
+  static_assert(SkippingDeserializer<BitPackingSourceDeserializer>);
+  static_assert(IncrementalDeserializer<BitPackingSourceDeserializer>);
 
   BitPackingSinkSerializer::BitPackingSinkSerializer(std::ostream& os)
       : BitPackingSinkSerializer([&os](std::byte byte) {
@@ -41,13 +47,40 @@ namespace serialize {
     }
   }
 
-  void BitPackingSinkSerializer::write(intmax_t val) { return writeBits(cache, sink, encodeSignedExpGolomb(val)); }
+  void BitPackingSinkSerializer::write(intmax_t val) {
+    if (val == std::numeric_limits<intmax_t>::min()) {
+      return writeWideExpGolomb(cache, sink, 1);
+    }
+    writeBits(cache, sink, encodeSignedExpGolomb(val));
+  }
 
   void BitPackingSinkSerializer::write(uintmax_t val) {
+    if (val == std::numeric_limits<uintmax_t>::max()) {
+      return writeWideExpGolomb(cache, sink, 0);
+    }
     // write as Exp-Golomb
     writeBits(cache, sink, encodeExpGolomb(val));
   }
 
+  void BitPackingSinkSerializer::splice(BitPackingSinkSerializer&& other, std::span<const std::byte> data) {
+    if (cache.usedBits == 0) {
+      // byte-aligned, can directly pass on the bytes
+      for (auto byte : data) {
+        sink(byte);
+      }
+    } else {
+      // not byte-aligned, need to shift all bytes through the cache
+      for (auto byte : data) {
+        writeBits(cache, sink, BitValue{std::to_integer<uintmax_t>(byte), CHAR_BIT});
+      }
+    }
+    if (other.cache.usedBits) {
+      // the other cache is left-adjusted
+      writeBits(cache, sink, BitValue{other.cache.value >> (CACHE_SIZE - other.cache.usedBits), other.cache.usedBits});
+      other.cache = BitCache{};
+    }
+  }
+
   void BitPackingSinkSerializer::flush() {
     flushFullBytes(cache, sink);
     // append trailing zeroes until we fill the last byte
@@ -68,40 +101,97 @@ namespace serialize {
         }) {}
 
   void BitPackingSourceDeserializer::read(float& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BitPackingSourceDeserializer::read(double& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BitPackingSourceDeserializer::read(long double& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BitPackingSourceDeserializer::read(intmax_t& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BitPackingSourceDeserializer::read(uintmax_t& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  bool BitPackingSourceDeserializer::tryRead(float& val) {
     uint32_t tmp = 0;
-    read(tmp);
+    if (!tryRead(tmp)) {
+      return false;
+    }
     // Revert bits back, see writer comment
     val = std::bit_cast<float>(reverseBits<uint32_t>(tmp));
+    return true;
   }
 
-  void BitPackingSourceDeserializer::read(double& val) {
+  bool BitPackingSourceDeserializer::tryRead(double& val) {
     uint64_t tmp = 0;
-    read(tmp);
+    if (!tryRead(tmp)) {
+      return false;
+    }
     val = std::bit_cast<double>(reverseBits<uint64_t>(tmp));
+    return true;
   }
 
-  void BitPackingSourceDeserializer::read(long double& val) {
+  bool BitPackingSourceDeserializer::tryRead(long double& val) {
     static_assert(sizeof(long double) % sizeof(uint64_t) == 0);
     std::array<uint64_t, sizeof(long double) / sizeof(uint64_t)> data{};
+    auto previousCache = cache;
     for (auto& entry : data) {
-      read(entry);
+      if (!tryRead(entry)) {
+        cache = previousCache;
+        return false;
+      }
       entry = reverseBits<uint64_t>(entry);
     }
     val = std::bit_cast<long double>(data);
+    return true;
   }
 
-  void BitPackingSourceDeserializer::read(intmax_t& val) {
+  bool BitPackingSourceDeserializer::tryRead(intmax_t& val) {
+    auto previousCache = cache;
     if (auto encoded = readExGolombBits(cache, source); encoded.numBits) {
-      val = decodeSignedExpGolomb(encoded.value);
-    } else {
-      detail::throwOnEof();
+      // the only valid wide code is the one for INTMAX_MIN, see #writeWideExpGolomb
+      val = encoded.numBits > CACHE_SIZE ? std::numeric_limits<intmax_t>::min()
+                                         : decodeSignedExpGolomb(encoded.value);
+      return true;
     }
+    cache = previousCache;
+    return false;
   }
-  void BitPackingSourceDeserializer::read(uintmax_t& val) {
+
+  bool BitPackingSourceDeserializer::tryRead(uintmax_t& val) {
+    auto previousCache = cache;
     if (auto encoded = readExGolombBits(cache, source); encoded.numBits) {
+      // for the wide code of UINTMAX_MAX, the lower bits of the code number (all zero) wrap around to the correct value
       val = decodeExpGolomb(encoded.value);
-    } else {
-      detail::throwOnEof();
+      return true;
+    }
+    cache = previousCache;
+    return false;
+  }
+
+  void BitPackingSourceDeserializer::skipCodes(std::size_t numCodes) {
+    for (std::size_t i = 0; i < numCodes; ++i) {
+      if (!skipExGolombBits(cache, source)) {
+        detail::throwOnEof();
+      }
     }
   }
 
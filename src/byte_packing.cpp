@@ -6,6 +6,9 @@
 
 #include "byte_packing.hpp"
 
+#include "resumable.hpp"
+#include "skip.hpp"
+
 #include <array>
 #include <bit>
 
@@ -13,7 +16,10 @@ namespace serialize {
 
   static_assert(Serializer<BytePackingSinkSerializer>);
   static_assert(!ByteSerializer<BytePackingSinkSerializer>);
+  static_assert(SplicingSerializer<BytePackingSinkSerializer>);
   static_assert(Deserializer<BytePackingSourceDeserializer>);
+  static_assert(SkippingDeserializer<BytePackingSourceDeserializer>);
+  static_assert(IncrementalDeserializer<BytePackingSourceDeserializer>);
 
   static constexpr uint8_t BYTE_VALUE_MASK = 0x7F;
   static constexpr uint8_t BYTE_CONTINUATION_FLAG = 0x80;
@@ -28,6 +34,13 @@ namespace serialize {
           os.write(&tmp, 1);
         }) {}
 
+  void BytePackingSinkSerializer::splice(BytePackingSinkSerializer&& /* other */, std::span<const std::byte> data) {
+    // all values are written as whole bytes, so there is no pending state to take over
+    for (auto byte : data) {
+      sink(byte);
+    }
+  }
+
   void BytePackingSinkSerializer::write(float val) { write(std::bit_cast<uint32_t>(val)); }
   void BytePackingSinkSerializer::write(double val) { write(std::bit_cast<uint64_t>(val)); }
 
@@ -69,47 +82,103 @@ namespace serialize {
         }) {}
 
   void BytePackingSourceDeserializer::read(float& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BytePackingSourceDeserializer::read(double& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BytePackingSourceDeserializer::read(long double& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BytePackingSourceDeserializer::read(intmax_t& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  void BytePackingSourceDeserializer::read(uintmax_t& val) {
+    if (!tryRead(val)) {
+      detail::throwOnEof();
+    }
+  }
+
+  bool BytePackingSourceDeserializer::tryRead(float& val) {
     uint32_t tmp = 0;
-    read(tmp);
+    if (!tryRead(tmp)) {
+      return false;
+    }
     val = std::bit_cast<float>(tmp);
+    return true;
   }
 
-  void BytePackingSourceDeserializer::read(double& val) {
+  bool BytePackingSourceDeserializer::tryRead(double& val) {
     uint64_t tmp = 0;
-    read(tmp);
+    if (!tryRead(tmp)) {
+      return false;
+    }
     val = std::bit_cast<double>(tmp);
+    return true;
   }
 
-  void BytePackingSourceDeserializer::read(long double& val) {
+  bool BytePackingSourceDeserializer::tryRead(long double& val) {
     static_assert(sizeof(long double) % sizeof(uint64_t) == 0);
     std::array<uint64_t, sizeof(long double) / sizeof(uint64_t)> data{};
     for (auto& entry : data) {
-      read(entry);
+      if (!tryRead(entry)) {
+        return false;
+      }
     }
     val = std::bit_cast<long double>(data);
+    return true;
   }
 
-  void BytePackingSourceDeserializer::read(intmax_t& val) {
+  bool BytePackingSourceDeserializer::tryRead(intmax_t& val) {
     uintmax_t tmp = 0;
-    read(tmp);
+    if (!tryRead(tmp)) {
+      return false;
+    }
     val = std::bit_cast<intmax_t>(tmp);
+    return true;
   }
 
-  void BytePackingSourceDeserializer::read(uintmax_t& val) {
-    val = 0;
+  bool BytePackingSourceDeserializer::tryRead(uintmax_t& val) {
+    uintmax_t tmp = 0;
     uint32_t offset = 0;
     std::byte byte{};
     while (source(byte)) {
       bool hasMore = std::bit_cast<uint8_t>(byte) & BYTE_CONTINUATION_FLAG;
       uintmax_t current = std::bit_cast<uint8_t>(byte) & BYTE_VALUE_MASK;
-      val |= current << offset;
+      tmp |= current << offset;
       offset += BYTE_CONTINUATION_OFFSET;
 
       if (!hasMore) {
-        return;
+        val = tmp;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void BytePackingSourceDeserializer::skipCodes(std::size_t numCodes) {
+    std::byte byte{};
+    while (numCodes) {
+      if (!source(byte)) {
+        detail::throwOnEof();
+      }
+      if (!(std::bit_cast<uint8_t>(byte) & BYTE_CONTINUATION_FLAG)) {
+        // last byte of the current value
+        --numCodes;
       }
     }
-    detail::throwOnEof();
   }
 
 } // namespace serialize
@@ -0,0 +1,230 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "checksum.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "framed.hpp"
+#include "simple.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define SERIALIZE_CRC32C_SSE42 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SERIALIZE_CRC32C_ARM 1
+#endif
+
+namespace serialize {
+
+  static_assert(ByteSerializer<ChecksummedSerializer<SimpleStreamSerializer>>);
+  static_assert(Serializer<ChecksummedSerializer<BitPackingSinkSerializer>>);
+  static_assert(SkippingDeserializer<ChecksummedDeserializer<SimpleStreamDeserializer>>);
+  static_assert(SkippingDeserializer<ChecksummedDeserializer<BytePackingSourceDeserializer>>);
+
+  namespace detail {
+    // reversed Castagnoli polynomial
+    static constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+    using Crc32cTables = std::array<std::array<uint32_t, 256>, 8>;
+
+    static constexpr Crc32cTables createCrc32cTables() noexcept {
+      Crc32cTables tables{};
+      for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (unsigned bit = 0; bit < 8; ++bit) {
+          crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+        }
+        tables[0][i] = crc;
+      }
+      for (std::size_t table = 1; table < tables.size(); ++table) {
+        for (std::size_t i = 0; i < 256; ++i) {
+          auto previous = tables[table - 1][i];
+          tables[table][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+      }
+      return tables;
+    }
+
+    static constexpr Crc32cTables CRC32C_TABLES = createCrc32cTables();
+
+    static uint32_t updateCrc32cSoftware(uint32_t crc, std::span<const std::byte> data) noexcept {
+      const auto& tables = CRC32C_TABLES;
+      if constexpr (std::endian::native == std::endian::little) {
+        for (; data.size() >= sizeof(uint64_t); data = data.subspan(sizeof(uint64_t))) {
+          uint64_t word = 0;
+          std::memcpy(&word, data.data(), sizeof(word));
+          word ^= crc;
+          crc = tables[7][word & 0xFF] ^ tables[6][(word >> 8) & 0xFF] ^ tables[5][(word >> 16) & 0xFF] ^
+                tables[4][(word >> 24) & 0xFF] ^ tables[3][(word >> 32) & 0xFF] ^ tables[2][(word >> 40) & 0xFF] ^
+                tables[1][(word >> 48) & 0xFF] ^ tables[0][word >> 56];
+        }
+      }
+      for (auto byte : data) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ std::to_integer<uint32_t>(byte)) & 0xFF];
+      }
+      return crc;
+    }
+
+#if defined(SERIALIZE_CRC32C_SSE42)
+    __attribute__((target("sse4.2"))) static uint32_t updateCrc32cHardware(uint32_t crc,
+                                                                          std::span<const std::byte> data) noexcept {
+      uint64_t crc64 = crc;
+      for (; data.size() >= sizeof(uint64_t); data = data.subspan(sizeof(uint64_t))) {
+        uint64_t word = 0;
+        std::memcpy(&word, data.data(), sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+      }
+      crc = static_cast<uint32_t>(crc64);
+      for (auto byte : data) {
+        crc = _mm_crc32_u8(crc, std::to_integer<uint8_t>(byte));
+      }
+      return crc;
+    }
+
+    static bool hasHardwareCrc32c() noexcept { return __builtin_cpu_supports("sse4.2"); }
+#elif defined(SERIALIZE_CRC32C_ARM)
+    static uint32_t updateCrc32cHardware(uint32_t crc, std::span<const std::byte> data) noexcept {
+      for (; data.size() >= sizeof(uint64_t); data = data.subspan(sizeof(uint64_t))) {
+        uint64_t word = 0;
+        std::memcpy(&word, data.data(), sizeof(word));
+        crc = __crc32cd(crc, word);
+      }
+      for (auto byte : data) {
+        crc = __crc32cb(crc, std::to_integer<uint8_t>(byte));
+      }
+      return crc;
+    }
+
+    static bool hasHardwareCrc32c() noexcept { return true; }
+#else
+    static uint32_t updateCrc32cHardware(uint32_t crc, std::span<const std::byte> data) noexcept {
+      return updateCrc32cSoftware(crc, data);
+    }
+
+    static bool hasHardwareCrc32c() noexcept { return false; }
+#endif
+
+    uint32_t crc32c(std::span<const std::byte> data, uint32_t previous) noexcept {
+      static const auto update = hasHardwareCrc32c() ? &updateCrc32cHardware : &updateCrc32cSoftware;
+      return ~update(~previous, data);
+    }
+
+    uint32_t crc32cSoftware(std::span<const std::byte> data, uint32_t previous) noexcept {
+      return ~updateCrc32cSoftware(~previous, data);
+    }
+
+    /*
+     * Each block is written as the block size (as BytePacking variable-length integer), the 4-byte little-endian
+     * CRC-32C checksum of the block data and the block data itself.
+     */
+    static std::array<char, sizeof(uint32_t)> encodeChecksum(uint32_t checksum) {
+      std::array<char, sizeof(uint32_t)> bytes{};
+      for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>((checksum >> (8 * i)) & 0xFF);
+      }
+      return bytes;
+    }
+
+    static uint32_t decodeChecksum(const std::array<char, sizeof(uint32_t)>& bytes) {
+      uint32_t checksum = 0;
+      for (std::size_t i = 0; i < bytes.size(); ++i) {
+        checksum |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+      }
+      return checksum;
+    }
+
+    ChecksummingStreamBuffer::ChecksummingStreamBuffer(std::ostream& out, std::size_t blockSize)
+        : out(out), block(std::max(blockSize, std::size_t{1})) {
+      setp(block.data(), block.data() + block.size());
+    }
+
+    ChecksummingStreamBuffer::~ChecksummingStreamBuffer() noexcept {
+      try {
+        writeBlock();
+      } catch (...) {
+        // nothing we can do here
+      }
+    }
+
+    ChecksummingStreamBuffer::int_type ChecksummingStreamBuffer::overflow(int_type ch) {
+      writeBlock();
+      if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    int ChecksummingStreamBuffer::sync() {
+      writeBlock();
+      return out.flush() ? 0 : -1;
+    }
+
+    void ChecksummingStreamBuffer::writeBlock() {
+      auto size = static_cast<std::size_t>(pptr() - pbase());
+      if (size) {
+        auto data = std::as_bytes(std::span{block}.first(size));
+        BytePackingSinkSerializer{out}.write(uintmax_t{size});
+        auto checksum = encodeChecksum(crc32c(data));
+        out.write(checksum.data(), checksum.size());
+        out.write(block.data(), static_cast<std::streamsize>(size));
+      }
+      setp(block.data(), block.data() + block.size());
+    }
+
+    VerifyingStreamBuffer::VerifyingStreamBuffer(std::istream& in, std::size_t maxBlockSize)
+        : in(in), maxBlockSize(std::max(maxBlockSize, std::size_t{1})) {
+      setg(nullptr, nullptr, nullptr);
+    }
+
+    VerifyingStreamBuffer::int_type VerifyingStreamBuffer::underflow() {
+      if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+      }
+      // skip empty blocks
+      do {
+        auto size = readFrameSize(in);
+        if (!size) {
+          setg(nullptr, nullptr, nullptr);
+          return traits_type::eof();
+        }
+        if (*size > maxBlockSize) {
+          // the block size is not covered by the checksum, so do not allocate memory for a corrupted size
+          setg(nullptr, nullptr, nullptr);
+          throw std::domain_error{"Block size exceeds the maximum block size, data is corrupted"};
+        }
+        std::array<char, sizeof(uint32_t)> checksum{};
+        if (!in.read(checksum.data(), checksum.size())) {
+          throwOnEof();
+        }
+        readFramePayload(in, *size, maxBlockSize, block);
+        if (crc32c(block) != decodeChecksum(checksum)) {
+          setg(nullptr, nullptr, nullptr);
+          throw std::domain_error{"Checksum mismatch, data is corrupted"};
+        }
+      } while (block.empty());
+      auto* start = reinterpret_cast<char*>(block.data());
+      setg(start, start, start + block.size());
+      return traits_type::to_int_type(*gptr());
+    }
+  } // namespace detail
+
+  ChecksummedOutputStream::ChecksummedOutputStream(std::ostream& out, std::size_t blockSize)
+      : detail::ChecksummingStreamBuffer(out, blockSize),
+        std::ostream(static_cast<detail::ChecksummingStreamBuffer*>(this)) {}
+
+  ChecksummedInputStream::ChecksummedInputStream(std::istream& in, std::size_t maxBlockSize)
+      : detail::VerifyingStreamBuffer(in, maxBlockSize), std::istream(static_cast<detail::VerifyingStreamBuffer*>(this)) {}
+
+} // namespace serialize
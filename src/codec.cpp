@@ -0,0 +1,29 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "codec.hpp"
+
+#include "fixed_buffer.hpp"
+#include "simple.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace serialize {
+
+  static_assert(NativeBlockSerializer<SimpleStreamSerializer>);
+  static_assert(NativeBlockDeserializer<SimpleStreamDeserializer>);
+  static_assert(NativeBlockSerializer<FixedBufferSerializer<16>>);
+  static_assert(NativeBlockDeserializer<FixedBufferDeserializer>);
+
+  namespace detail {
+    void throwOnFixedSizeMismatch(std::size_t expected, std::size_t actual) {
+      throw std::domain_error{"Expected fixed-size container of " + std::to_string(expected) + " elements, got " +
+                              std::to_string(actual)};
+    }
+  } // namespace detail
+
+} // namespace serialize
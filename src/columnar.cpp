@@ -0,0 +1,36 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "columnar.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace serialize {
+
+  namespace detail {
+    static_assert(decodeZigZag(encodeZigZag(0)) == 0);
+    static_assert(encodeZigZag(-1) == 1);
+    static_assert(decodeZigZag(encodeZigZag(std::numeric_limits<int64_t>::min())) ==
+                  std::numeric_limits<int64_t>::min());
+    static_assert(decodeZigZag(encodeZigZag(std::numeric_limits<int64_t>::max())) ==
+                  std::numeric_limits<int64_t>::max());
+    static_assert(wrappingAdd(uint8_t{250}, wrappingDelta(uint8_t{3}, uint8_t{250})) == 3);
+    static_assert(wrappingAdd(int16_t{-7}, static_cast<int64_t>(wrappingOffset(int16_t{32000}, int16_t{-7}))) ==
+                  32000);
+
+    void throwOnInvalidColumnEncoding(uint8_t encoding) {
+      throw std::domain_error{"Invalid column encoding " + std::to_string(static_cast<unsigned>(encoding)) +
+                              " for the column type"};
+    }
+
+    void throwOnColumnSizeMismatch(std::size_t expectedSize, std::size_t actualSize) {
+      throw std::domain_error{"Invalid column size " + std::to_string(actualSize) + ", expected " +
+                              std::to_string(expectedSize)};
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -8,6 +8,8 @@
 #include "serialize.hpp"
 
 #include <array>
+#include <bit>
+#include <bitset>
 #include <map>
 #include <set>
 #include <string>
@@ -46,4 +48,7 @@ namespace serialize {
   static_assert(DeserializableGrowableContainer<std::unordered_set<int>>);
   static_assert(DeserializableGrowableContainer<std::unordered_set<std::string>>);
   static_assert(DeserializableGrowableContainer<std::vector<std::string>>);
+
+  // the common standard library implementations store the bits of a std::bitset in ascending order
+  static_assert(std::endian::native != std::endian::little || detail::hasPackedBitsetLayout<1000>());
 } // namespace serialize
@@ -0,0 +1,405 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "compression.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "framed.hpp"
+#include "simple.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace serialize {
+
+  static_assert(ByteSerializer<CompressedSerializer<SimpleStreamSerializer>>);
+  static_assert(Serializer<CompressedSerializer<BitPackingSinkSerializer>>);
+  static_assert(SkippingDeserializer<CompressedDeserializer<SimpleStreamDeserializer>>);
+  static_assert(SkippingDeserializer<CompressedDeserializer<BytePackingSourceDeserializer>>);
+
+  namespace detail {
+
+    /*
+     * The compressed block format is similar to the LZ4 block format:
+     *
+     * The block consists of a sequence of (literals, match) pairs, each starting with a token byte with the upper 4
+     * bits holding the number of literals and the lower 4 bits holding the match length (minus the minimum match
+     * length). A value of 15 indicates additional length bytes (each adding 0 to 255 to the length, terminated by a
+     * byte < 255) after the token for the literals and after the match offset for the match length.
+     *
+     * The token is followed by the literal bytes and the 2-byte little-endian offset of the match (counting backwards
+     * from the current output position). The last sequence of the block only contains literals (and possibly zero of
+     * them).
+     */
+    static constexpr std::size_t MIN_MATCH_LENGTH = 4;
+    static constexpr std::size_t MAX_MATCH_OFFSET = 0xFFFF;
+    static constexpr std::size_t HASH_BITS = 14;
+    static constexpr std::size_t LENGTH_MASK = 0xF;
+
+    static uint32_t load32(const std::byte* ptr) {
+      uint32_t val = 0;
+      std::memcpy(&val, ptr, sizeof(val));
+      return val;
+    }
+
+    static std::size_t hashSequence(uint32_t sequence) {
+      // Fibonacci hashing of the next 4 bytes
+      return static_cast<uint32_t>(sequence * 2654435761U) >> (32 - HASH_BITS);
+    }
+
+    static void writeExtraLength(std::vector<std::byte>& output, std::size_t length) {
+      for (; length >= 0xFF; length -= 0xFF) {
+        output.push_back(std::byte{0xFF});
+      }
+      output.push_back(static_cast<std::byte>(length));
+    }
+
+    static void writeSequence(std::vector<std::byte>& output, std::span<const std::byte> literals,
+                              std::size_t matchLength, std::size_t matchOffset) {
+      auto literalsToken = std::min(literals.size(), LENGTH_MASK);
+      auto matchToken = matchLength ? std::min(matchLength - MIN_MATCH_LENGTH, LENGTH_MASK) : 0;
+      output.push_back(static_cast<std::byte>((literalsToken << 4) | matchToken));
+      if (literalsToken == LENGTH_MASK) {
+        writeExtraLength(output, literals.size() - LENGTH_MASK);
+      }
+      output.insert(output.end(), literals.begin(), literals.end());
+      if (matchLength) {
+        output.push_back(static_cast<std::byte>(matchOffset & 0xFF));
+        output.push_back(static_cast<std::byte>(matchOffset >> 8));
+        if (matchToken == LENGTH_MASK) {
+          writeExtraLength(output, matchLength - MIN_MATCH_LENGTH - LENGTH_MASK);
+        }
+      }
+    }
+
+    static std::size_t readExtraLength(std::span<const std::byte> input, std::size_t& position) {
+      std::size_t length = 0;
+      while (true) {
+        if (position >= input.size()) {
+          throw std::domain_error{"Truncated length in compressed block"};
+        }
+        auto byte = std::to_integer<std::size_t>(input[position++]);
+        length += byte;
+        if (byte != 0xFF) {
+          return length;
+        }
+      }
+    }
+
+    void compressBlock(std::span<const std::byte> input, std::vector<std::byte>& output) {
+      // positions (plus one, zero marks an unused entry) of the last occurrence of the hashed 4-byte sequences
+      thread_local std::vector<uint32_t> hashTable{};
+      hashTable.assign(std::size_t{1} << HASH_BITS, 0);
+
+      output.clear();
+      output.reserve(input.size() + input.size() / 255 + 16);
+      std::size_t anchor = 0;
+      std::size_t position = 0;
+      while (input.size() >= MIN_MATCH_LENGTH && position <= input.size() - MIN_MATCH_LENGTH) {
+        auto sequence = load32(&input[position]);
+        auto& entry = hashTable[hashSequence(sequence)];
+        std::size_t candidate = entry;
+        entry = static_cast<uint32_t>(position + 1);
+        if (candidate && position - (candidate - 1) <= MAX_MATCH_OFFSET && load32(&input[candidate - 1]) == sequence) {
+          auto matchStart = candidate - 1;
+          auto matchLength = MIN_MATCH_LENGTH;
+          while (position + matchLength < input.size() &&
+                 input[matchStart + matchLength] == input[position + matchLength]) {
+            ++matchLength;
+          }
+          writeSequence(output, input.subspan(anchor, position - anchor), matchLength, position - matchStart);
+          position += matchLength;
+          anchor = position;
+        } else {
+          // skip faster through incompressible data
+          position += 1 + ((position - anchor) >> 6);
+        }
+      }
+      writeSequence(output, input.subspan(anchor), 0, 0);
+    }
+
+    void decompressBlock(std::span<const std::byte> input, std::span<std::byte> output) {
+      std::size_t inPos = 0;
+      std::size_t outPos = 0;
+      while (true) {
+        if (inPos >= input.size()) {
+          throw std::domain_error{"Truncated compressed block"};
+        }
+        auto token = std::to_integer<std::size_t>(input[inPos++]);
+        auto numLiterals = token >> 4;
+        if (numLiterals == LENGTH_MASK) {
+          numLiterals += readExtraLength(input, inPos);
+        }
+        if (numLiterals > input.size() - inPos || numLiterals > output.size() - outPos) {
+          throw std::domain_error{"Literals out of bounds in compressed block"};
+        }
+        std::copy_n(input.begin() + static_cast<std::ptrdiff_t>(inPos), numLiterals,
+                    output.begin() + static_cast<std::ptrdiff_t>(outPos));
+        inPos += numLiterals;
+        outPos += numLiterals;
+        if (inPos == input.size()) {
+          // last sequence
+          break;
+        }
+
+        if (input.size() - inPos < 2) {
+          throw std::domain_error{"Truncated match offset in compressed block"};
+        }
+        auto matchOffset =
+            std::to_integer<std::size_t>(input[inPos]) | (std::to_integer<std::size_t>(input[inPos + 1]) << 8);
+        inPos += 2;
+        auto matchLength = (token & LENGTH_MASK) + MIN_MATCH_LENGTH;
+        if ((token & LENGTH_MASK) == LENGTH_MASK) {
+          matchLength += readExtraLength(input, inPos);
+        }
+        if (matchOffset == 0 || matchOffset > outPos || matchLength > output.size() - outPos) {
+          throw std::domain_error{"Match out of bounds in compressed block"};
+        }
+        auto matchPos = outPos - matchOffset;
+        if (matchOffset >= matchLength) {
+          std::memcpy(&output[outPos], &output[matchPos], matchLength);
+          outPos += matchLength;
+        } else {
+          // the match overlaps with the bytes it produces, so copy byte by byte
+          for (; matchLength > 0; --matchLength) {
+            output[outPos++] = output[matchPos++];
+          }
+        }
+      }
+      if (outPos != output.size()) {
+        throw std::domain_error{"Compressed block size mismatch"};
+      }
+    }
+
+    void encodeCompressedBlock(std::span<const std::byte> data, std::vector<std::byte>& encoded,
+                               std::vector<std::byte>& scratch) {
+      compressBlock(data, scratch);
+      // a stored size equal to the uncompressed size marks an uncompressed block
+      auto stored = scratch.size() < data.size() ? std::span<const std::byte>{scratch} : data;
+      encoded.clear();
+      BytePackingSinkSerializer header{[&encoded](std::byte byte) { encoded.push_back(byte); }};
+      header.write(uintmax_t{data.size()});
+      header.write(uintmax_t{stored.size()});
+      encoded.insert(encoded.end(), stored.begin(), stored.end());
+    }
+
+    bool readStoredBlock(std::istream& in, std::size_t maxBlockSize, std::size_t& blockSize,
+                         std::vector<std::byte>& stored) {
+      auto size = readFrameSize(in);
+      if (!size) {
+        return false;
+      }
+      if (*size > maxBlockSize) {
+        throw std::domain_error{"Block size exceeds the maximum block size, data is corrupted"};
+      }
+      auto storedSize = readFrameSize(in);
+      if (!storedSize) {
+        throwOnEof();
+      }
+      if (*storedSize > *size) {
+        throw std::domain_error{"Invalid compressed block header"};
+      }
+      blockSize = *size;
+      readFramePayload(in, *storedSize, maxBlockSize, stored);
+      return true;
+    }
+
+    void decodeStoredBlock(std::size_t blockSize, std::vector<std::byte>& stored, std::vector<std::byte>& data) {
+      if (stored.size() == blockSize) {
+        std::swap(stored, data);
+        return;
+      }
+      data.resize(blockSize);
+      decompressBlock(stored, data);
+    }
+
+    template <typename Block> static std::unique_ptr<Block> takeSpareBlock(std::vector<std::unique_ptr<Block>>& spare) {
+      if (spare.empty()) {
+        return std::make_unique<Block>();
+      }
+      auto block = std::move(spare.back());
+      spare.pop_back();
+      block->error = nullptr;
+      block->done = false;
+      return block;
+    }
+
+    CompressingStreamBuffer::CompressingStreamBuffer(std::ostream& out, std::size_t blockSize, ThreadPool* pool)
+        : out(out), blockSize(std::max(blockSize, std::size_t{1})), pool(pool), current(std::make_unique<Block>()) {
+      current->data.resize(this->blockSize);
+      setp(current->data.data(), current->data.data() + this->blockSize);
+    }
+
+    CompressingStreamBuffer::~CompressingStreamBuffer() noexcept {
+      try {
+        submitBlock();
+        writeCompletedBlocks(0);
+      } catch (...) {
+        // nothing we can do here
+      }
+      // the in-flight tasks reference this object, so we need to wait for them in any case
+      waitForInFlightBlocks();
+    }
+
+    CompressingStreamBuffer::int_type CompressingStreamBuffer::overflow(int_type ch) {
+      submitBlock();
+      if (pool) {
+        writeCompletedBlocks(2 * pool->size());
+      }
+      if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    int CompressingStreamBuffer::sync() {
+      submitBlock();
+      writeCompletedBlocks(0);
+      return out.flush() ? 0 : -1;
+    }
+
+    void CompressingStreamBuffer::submitBlock() {
+      current->size = static_cast<std::size_t>(pptr() - pbase());
+      if (current->size && !pool) {
+        encodeCompressedBlock(std::as_bytes(std::span{current->data}.first(current->size)), current->encoded,
+                              current->scratch);
+        out.write(reinterpret_cast<const char*>(current->encoded.data()),
+                  static_cast<std::streamsize>(current->encoded.size()));
+      } else if (current->size) {
+        // keeps the current block if submitting fails
+        submitInFlight(*pool, inFlight, current, mutex, condition, [](Block& block) {
+          encodeCompressedBlock(std::as_bytes(std::span{block.data}.first(block.size)), block.encoded, block.scratch);
+        });
+        current = takeSpareBlock(spareBlocks);
+        current->data.resize(blockSize);
+      }
+      setp(current->data.data(), current->data.data() + blockSize);
+    }
+
+    void CompressingStreamBuffer::writeCompletedBlocks(std::size_t maxPending) {
+      while (!inFlight.empty()) {
+        {
+          std::unique_lock lock{mutex};
+          auto& head = *inFlight.front();
+          if (inFlight.size() > maxPending) {
+            condition.wait(lock, [&head]() { return head.done; });
+          } else if (!head.done) {
+            break;
+          }
+        }
+        auto& block = spareBlocks.emplace_back(std::move(inFlight.front()));
+        inFlight.pop_front();
+        if (block->error) {
+          std::rethrow_exception(block->error);
+        }
+        out.write(reinterpret_cast<const char*>(block->encoded.data()),
+                  static_cast<std::streamsize>(block->encoded.size()));
+      }
+    }
+
+    void CompressingStreamBuffer::waitForInFlightBlocks() {
+      std::unique_lock lock{mutex};
+      condition.wait(lock, [this]() {
+        return std::ranges::all_of(inFlight, [](const auto& block) { return block->done; });
+      });
+    }
+
+    DecompressingStreamBuffer::DecompressingStreamBuffer(std::istream& in, ThreadPool* pool, std::size_t maxBlockSize)
+        : in(in), pool(pool), maxBlockSize(std::max(maxBlockSize, std::size_t{1})) {
+      setg(nullptr, nullptr, nullptr);
+    }
+
+    DecompressingStreamBuffer::~DecompressingStreamBuffer() noexcept {
+      // the in-flight tasks reference this object, so we need to wait for them
+      waitForInFlightBlocks();
+    }
+
+    DecompressingStreamBuffer::int_type DecompressingStreamBuffer::underflow() {
+      if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+      }
+      while (nextBlock()) {
+        // skip empty blocks
+        if (!current->data.empty()) {
+          auto* start = reinterpret_cast<char*>(current->data.data());
+          setg(start, start, start + current->data.size());
+          return traits_type::to_int_type(*gptr());
+        }
+      }
+      setg(nullptr, nullptr, nullptr);
+      return traits_type::eof();
+    }
+
+    bool DecompressingStreamBuffer::nextBlock() {
+      if (current) {
+        spareBlocks.emplace_back(std::move(current));
+      }
+      if (!pool) {
+        auto block = takeSpareBlock(spareBlocks);
+        if (!readStoredBlock(in, maxBlockSize, block->size, block->stored)) {
+          spareBlocks.emplace_back(std::move(block));
+          return false;
+        }
+        decodeStoredBlock(block->size, block->stored, block->data);
+        current = std::move(block);
+        return true;
+      }
+
+      // read ahead the next blocks and decompress them in parallel
+      const std::size_t maxInFlight = 2 * pool->size() + 1;
+      while (inFlight.size() < maxInFlight) {
+        auto block = takeSpareBlock(spareBlocks);
+        if (!readStoredBlock(in, maxBlockSize, block->size, block->stored)) {
+          spareBlocks.emplace_back(std::move(block));
+          break;
+        }
+        submitInFlight(*pool, inFlight, block, mutex, condition,
+                       [](Block& item) { decodeStoredBlock(item.size, item.stored, item.data); });
+      }
+      if (inFlight.empty()) {
+        return false;
+      }
+      {
+        std::unique_lock lock{mutex};
+        condition.wait(lock, [this]() { return inFlight.front()->done; });
+      }
+      current = std::move(inFlight.front());
+      inFlight.pop_front();
+      if (current->error) {
+        std::rethrow_exception(current->error);
+      }
+      return true;
+    }
+
+    void DecompressingStreamBuffer::waitForInFlightBlocks() {
+      std::unique_lock lock{mutex};
+      condition.wait(lock, [this]() {
+        return std::ranges::all_of(inFlight, [](const auto& block) { return block->done; });
+      });
+    }
+  } // namespace detail
+
+  CompressingOutputStream::CompressingOutputStream(std::ostream& out, std::size_t blockSize)
+      : detail::CompressingStreamBuffer(out, blockSize, nullptr),
+        std::ostream(static_cast<detail::CompressingStreamBuffer*>(this)) {}
+
+  CompressingOutputStream::CompressingOutputStream(std::ostream& out, ThreadPool& pool, std::size_t blockSize)
+      : detail::CompressingStreamBuffer(out, blockSize, &pool),
+        std::ostream(static_cast<detail::CompressingStreamBuffer*>(this)) {}
+
+  DecompressingInputStream::DecompressingInputStream(std::istream& in, std::size_t maxBlockSize)
+      : detail::DecompressingStreamBuffer(in, nullptr, maxBlockSize),
+        std::istream(static_cast<detail::DecompressingStreamBuffer*>(this)) {}
+
+  DecompressingInputStream::DecompressingInputStream(std::istream& in, ThreadPool& pool, std::size_t maxBlockSize)
+      : detail::DecompressingStreamBuffer(in, &pool, maxBlockSize),
+        std::istream(static_cast<detail::DecompressingStreamBuffer*>(this)) {}
+
+} // namespace serialize
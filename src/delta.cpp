@@ -0,0 +1,25 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "delta.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace serialize {
+
+  namespace detail {
+    static_assert(DeltaIndexedContainer<std::vector<int>>);
+    static_assert(DeltaIndexedContainer<std::array<double, 4>>);
+    static_assert(!DeltaIndexedContainer<std::vector<bool>>);
+    static_assert(!DeltaIndexedContainer<std::string>);
+
+    void throwOnInvalidDelta(const char* reason) { throw std::domain_error{std::string{"Invalid delta: "} + reason}; }
+  } // namespace detail
+
+} // namespace serialize
@@ -0,0 +1,30 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "fixed_buffer.hpp"
+
+#include "skip.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace serialize {
+
+  static_assert(Serializer<SizeCountingSerializer>);
+  static_assert(Serializer<FixedBufferSerializer<16>>);
+  static_assert(SkippingDeserializer<FixedBufferDeserializer>);
+
+  static_assert(serializedSize(uint32_t{42}) == sizeof(uint32_t));
+  static_assert(deserializeFromBuffer<uint32_t>(serializeToArray<sizeof(uint32_t)>(uint32_t{42})) == 42);
+
+  namespace detail {
+    void throwOnBufferOverflow(std::size_t capacity) {
+      throw std::out_of_range{"Serialized data exceeds the fixed buffer size of " + std::to_string(capacity) +
+                              " bytes"};
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -0,0 +1,50 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "framed.hpp"
+
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include <stdexcept>
+
+namespace serialize {
+
+  static_assert(std::ranges::input_range<FramedStreamReader<uint32_t, SimpleStreamDeserializer>>);
+  static_assert(std::input_iterator<FramedStreamReader<uint32_t, SimpleStreamDeserializer>::iterator>);
+
+  namespace detail {
+    void writeFrame(std::ostream& out, std::span<const std::byte> payload) {
+      BytePackingSinkSerializer{out}.write(uintmax_t{payload.size()});
+      out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    }
+
+    std::optional<std::size_t> readFrameSize(std::istream& in) {
+      if (in.peek() == std::istream::traits_type::eof()) {
+        // clear the EOF flag (and only that), so the stream can be continued to be read if more data is appended later on
+        in.clear(in.rdstate() & ~std::ios_base::eofbit);
+        return {};
+      }
+      BytePackingSourceDeserializer deserializer{in};
+      return deserialize<std::size_t>(deserializer);
+    }
+
+    void readFramePayload(std::istream& in, std::size_t size, std::size_t maxSize, std::vector<std::byte>& buffer) {
+      if (size > maxSize) {
+        throw std::domain_error{"Frame size exceeds the maximum frame size, data is corrupted"};
+      }
+      buffer.resize(size);
+      if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size))) {
+        throwOnEof();
+      }
+    }
+
+    void skipFramePayload(std::istream& in, std::size_t size) {
+      SimpleStreamDeserializer{in}.skip<uint8_t>(size);
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -0,0 +1,45 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "graph.hpp"
+
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include <concepts>
+#include <memory>
+#include <string>
+
+namespace serialize {
+
+  static_assert(ByteSerializer<ObjectGraphSerializer<SimpleStreamSerializer>>);
+  static_assert(Serializer<ObjectGraphSerializer<BytePackingSinkSerializer>>);
+  static_assert(SharingDeserializer<ObjectGraphDeserializer<SimpleStreamDeserializer>>);
+  static_assert(SkippingDeserializer<ObjectGraphDeserializer<BytePackingSourceDeserializer>>);
+  static_assert(!SharingDeserializer<SimpleStreamDeserializer>);
+  static_assert(std::invocable<decltype(deserialize<std::shared_ptr<int>>),
+                               ObjectGraphDeserializer<SimpleStreamDeserializer>&>);
+  static_assert(!std::invocable<decltype(deserialize<std::shared_ptr<int>>), SimpleStreamDeserializer&>);
+  static_assert(!std::invocable<decltype(deserialize<std::weak_ptr<int>>), SimpleStreamDeserializer&>);
+
+  namespace detail {
+    void throwOnInvalidSharedReference(std::size_t index, std::size_t numObjects) {
+      throw std::domain_error{"Invalid reference to shared object " + std::to_string(index) + ", only " +
+                              std::to_string(numObjects) + " objects are known"};
+    }
+
+    void throwOnSharedTypeMismatch(const std::type_info& expectedType, const std::type_info& actualType) {
+      throw std::domain_error{"Invalid type of referenced shared object, expected '" +
+                              std::string{expectedType.name()} + "', got '" + actualType.name() + "'"};
+    }
+
+    void throwOnIncompleteSharedObject(const std::type_info& type) {
+      throw std::domain_error{"Cyclic reference to shared object of non default-constructible type '" +
+                              std::string{type.name()} + "'"};
+    }
+  } // namespace detail
+
+} // namespace serialize
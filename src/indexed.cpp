@@ -0,0 +1,50 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "indexed.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace serialize {
+
+  static_assert(Serializer<detail::IndexedLeafSerializer>);
+  static_assert(ByteSerializer<detail::IndexedLeafSerializer>);
+  static_assert(Deserializer<detail::IndexedLeafDeserializer>);
+
+  namespace detail {
+    IndexedOffset toIndexedOffset(std::size_t offset) {
+      if (offset > std::numeric_limits<IndexedOffset>::max()) {
+        throw std::length_error{"Indexed record is too big for 32-bit offsets"};
+      }
+      return static_cast<IndexedOffset>(offset);
+    }
+
+    std::span<const std::byte> indexedSubspan(std::span<const std::byte> data, std::size_t offset) {
+      if (offset > data.size()) {
+        throwOnEof();
+      }
+      return data.subspan(offset);
+    }
+  } // namespace detail
+
+  void IndexedSerializer::writeRecord() {
+    auto size = static_cast<detail::IndexedSize>(buffer.size());
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  }
+
+  std::span<const std::byte> IndexedDeserializer::nextRecord() {
+    auto size = detail::loadIndexed<detail::IndexedSize>(data, position);
+    auto record = detail::indexedSubspan(data, position + sizeof(size));
+    if (record.size() < size) {
+      detail::throwOnEof();
+    }
+    position += sizeof(size) + static_cast<std::size_t>(size);
+    return record.first(static_cast<std::size_t>(size));
+  }
+
+} // namespace serialize
@@ -0,0 +1,112 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "instrumented.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+namespace serialize {
+
+  static_assert(Serializer<InstrumentedSerializer<SimpleStreamSerializer>>);
+  static_assert(ByteSerializer<InstrumentedSerializer<SimpleStreamSerializer>>);
+  static_assert(!ByteSerializer<InstrumentedSerializer<BitPackingSinkSerializer>>);
+  static_assert(Deserializer<InstrumentedDeserializer<BytePackingSourceDeserializer, true>>);
+  static_assert(SkippingDeserializer<InstrumentedDeserializer<SimpleStreamDeserializer>>);
+
+  static constexpr std::array<const char*, InstrumentationReport::NUM_FUNDAMENTAL_TYPES> FUNDAMENTAL_TYPE_NAMES = {
+      "bool",   "int8_t", "uint8_t",     "int16_t", "uint16_t", "int32_t", "uint32_t", "int64_t",  "uint64_t",
+      "float",  "double", "long double", "char",    "wchar_t",  "char8_t", "char16_t", "char32_t",
+  };
+  static_assert(detail::type_id_v<char32_t> + 1 == FUNDAMENTAL_TYPE_NAMES.size());
+
+  static void writeCounters(std::ostream& os, const std::string& name, const InstrumentationCounters& counters) {
+    os << std::left << std::setw(40) << name << std::right << std::setw(12) << counters.numValues << std::setw(14)
+       << counters.numBytes;
+    if (counters.duration.count()) {
+      os << std::setw(14) << counters.duration.count();
+    }
+    os << '\n';
+  }
+
+  std::ostream& operator<<(std::ostream& os, const InstrumentationReport& report) {
+    os << std::left << std::setw(40) << "Type" << std::right << std::setw(12) << "Values" << std::setw(14) << "Bytes"
+       << std::setw(14) << "Time (ns)" << '\n';
+    for (std::size_t i = 0; i < report.fundamentals.size(); ++i) {
+      if (report.fundamentals[i].numValues) {
+        writeCounters(os, FUNDAMENTAL_TYPE_NAMES[i], report.fundamentals[i]);
+      }
+    }
+    if (report.rawData.numBytes) {
+      writeCounters(os, "(raw data)", report.rawData);
+    }
+    for (const auto& [name, counters] : report.objects) {
+      writeCounters(os, name, counters);
+    }
+    return os << std::left << std::setw(40) << "Total" << std::right << std::setw(26) << report.totalBytes << '\n';
+  }
+
+  namespace detail {
+    std::string demangleTypeName(const char* name) {
+#if __has_include(<cxxabi.h>)
+      int status = 0;
+      std::unique_ptr<char, decltype(&std::free)> demangled{abi::__cxa_demangle(name, nullptr, nullptr, &status),
+                                                             &std::free};
+      if (status == 0 && demangled) {
+        return demangled.get();
+      }
+#endif
+      return name;
+    }
+
+    CountingOutputBuffer::int_type CountingOutputBuffer::overflow(int_type ch) {
+      if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+      }
+      auto result = target->sputc(traits_type::to_char_type(ch));
+      if (!traits_type::eq_int_type(result, traits_type::eof())) {
+        ++numBytes;
+      }
+      return result;
+    }
+
+    std::streamsize CountingOutputBuffer::xsputn(const char_type* s, std::streamsize count) {
+      auto numWritten = target->sputn(s, count);
+      numBytes += static_cast<std::size_t>(numWritten);
+      return numWritten;
+    }
+
+    int CountingOutputBuffer::sync() { return target->pubsync(); }
+
+    CountingInputBuffer::int_type CountingInputBuffer::underflow() { return target->sgetc(); }
+
+    CountingInputBuffer::int_type CountingInputBuffer::uflow() {
+      auto result = target->sbumpc();
+      if (!traits_type::eq_int_type(result, traits_type::eof())) {
+        ++numBytes;
+      }
+      return result;
+    }
+
+    std::streamsize CountingInputBuffer::xsgetn(char_type* s, std::streamsize count) {
+      auto numRead = target->sgetn(s, count);
+      numBytes += static_cast<std::size_t>(numRead);
+      return numRead;
+    }
+
+    std::streamsize CountingInputBuffer::showmanyc() { return target->in_avail(); }
+  } // namespace detail
+
+} // namespace serialize
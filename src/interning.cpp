@@ -0,0 +1,27 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "interning.hpp"
+
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+namespace serialize {
+
+  static_assert(ByteSerializer<StringInterningSerializer<SimpleStreamSerializer>>);
+  static_assert(Serializer<StringInterningSerializer<BytePackingSinkSerializer>>);
+  static_assert(StringDeserializer<StringInterningDeserializer<SimpleStreamDeserializer>>);
+  static_assert(SkippingDeserializer<StringInterningDeserializer<BytePackingSourceDeserializer>>);
+  static_assert(!StringDeserializer<SimpleStreamDeserializer>);
+
+  namespace detail {
+    void throwOnInvalidInternedReference(std::size_t index, std::size_t numEntries) {
+      throw std::domain_error{"Invalid back-reference to interned string " + std::to_string(index) + ", only " +
+                              std::to_string(numEntries) + " strings are interned"};
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -0,0 +1,88 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "lossy.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace serialize {
+
+  namespace detail {
+    static_assert(floatToBFloat16(1.0f) == 0x3F80);
+    static_assert(floatToBFloat16(-2.0f) == 0xC000);
+    // 1 + 2^-8 is exactly between two bfloat16 values and rounds to the even 1.0
+    static_assert(floatToBFloat16(1.00390625f) == 0x3F80);
+    static_assert(bFloat16ToFloat(0x4049) == 3.140625f);
+
+    uint16_t floatToHalf(float value) noexcept {
+#if defined(__F16C__)
+      return static_cast<uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+      auto bits = std::bit_cast<uint32_t>(value);
+      auto sign = (bits >> 16) & 0x8000U;
+      auto exponent = static_cast<int32_t>((bits >> 23) & 0xFFU);
+      auto mantissa = bits & 0x7FFFFFU;
+      if (exponent == 0xFF) {
+        // infinity or (quiet) NaN
+        return static_cast<uint16_t>(sign | 0x7C00U | (mantissa ? 0x0200U | (mantissa >> 13) : 0U));
+      }
+      auto halfExponent = exponent - 127 + 15;
+      if (halfExponent >= 0x1F) {
+        return static_cast<uint16_t>(sign | 0x7C00U);
+      }
+      uint32_t shift = 13;
+      if (halfExponent <= 0) {
+        if (halfExponent < -10) {
+          // less than half of the smallest subnormal value
+          return static_cast<uint16_t>(sign);
+        }
+        // subnormal, make the implicit leading bit explicit
+        mantissa |= 0x800000U;
+        shift = static_cast<uint32_t>(14 - halfExponent);
+        halfExponent = 0;
+      }
+      auto half = (static_cast<uint32_t>(halfExponent) << 10) + (mantissa >> shift);
+      auto remainder = mantissa & ((1U << shift) - 1U);
+      auto halfway = 1U << (shift - 1U);
+      if (remainder > halfway || (remainder == halfway && (half & 1U))) {
+        // might carry into the exponent, which is the correct rounding up to the next power of two (or infinity)
+        ++half;
+      }
+      return static_cast<uint16_t>(sign | half);
+#endif
+    }
+
+    float halfToFloat(uint16_t bits) noexcept {
+#if defined(__F16C__)
+      return _cvtsh_ss(bits);
+#else
+      auto sign = static_cast<uint32_t>(bits & 0x8000U) << 16;
+      auto exponent = static_cast<uint32_t>(bits >> 10) & 0x1FU;
+      auto mantissa = static_cast<uint32_t>(bits) & 0x3FFU;
+      if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13));
+      }
+      if (exponent == 0) {
+        // zero or subnormal
+        auto magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+      }
+      return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+#endif
+    }
+
+    void throwOnQuantizationOverflow(long double value) {
+      throw std::out_of_range{"Value is not representable as quantized integral value: " + std::to_string(value)};
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -0,0 +1,31 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "parallel.hpp"
+
+namespace serialize {
+
+  namespace detail {
+    bool readFrameBlock(std::istream& in, std::size_t maxFrames, FrameBlock& block) {
+      block.data.clear();
+      block.offsets.assign(1, 0);
+      for (std::size_t i = 0; i < maxFrames; ++i) {
+        auto size = readFrameSize(in);
+        if (!size) {
+          break;
+        }
+        auto start = block.data.size();
+        block.data.resize(start + *size);
+        if (!in.read(reinterpret_cast<char*>(block.data.data() + start), static_cast<std::streamsize>(*size))) {
+          throwOnEof();
+        }
+        block.offsets.push_back(block.data.size());
+      }
+      return block.size() > 0;
+    }
+  } // namespace detail
+
+} // namespace serialize
@@ -6,10 +6,30 @@
 
 #include "simple.hpp"
 
+#include "resumable.hpp"
+#include "skip.hpp"
+
 namespace serialize {
 
   static_assert(Serializer<SimpleStreamSerializer>);
   static_assert(ByteSerializer<SimpleStreamSerializer>);
+  static_assert(SplicingSerializer<SimpleStreamSerializer>);
   static_assert(Deserializer<SimpleStreamDeserializer>);
+  static_assert(SkippingDeserializer<SimpleStreamDeserializer>);
+  static_assert(IncrementalDeserializer<SimpleStreamDeserializer>);
+
+  void SimpleStreamDeserializer::skipBytes(std::size_t numBytes) {
+    auto numSkipped = static_cast<std::streamsize>(numBytes);
+    // Seeking is much cheaper than reading for seekable streams (e.g. files). Seeking past the end of a file is not an
+    // error, so EOF is only detected on the next read in that case.
+    if (in.tellg() != std::istream::pos_type(-1) && in.seekg(numSkipped, std::ios::cur)) {
+      return;
+    }
+    // Not seekable or seeking failed (e.g. past the end of a string stream), consume the bytes instead
+    in.clear(in.rdstate() & ~std::ios::failbit);
+    if (in.ignore(numSkipped).gcount() != numSkipped) {
+      detail::throwOnEof();
+    }
+  }
 
 } // namespace serialize
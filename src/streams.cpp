@@ -0,0 +1,79 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "streams.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace serialize {
+
+  namespace detail {
+    BufferStreamBuffer::int_type BufferStreamBuffer::overflow(int_type ch) {
+      if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+      }
+      grow(storage.size() + 1);
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+      return ch;
+    }
+
+    std::streamsize BufferStreamBuffer::xsputn(const char_type* s, std::streamsize count) {
+      if (count <= 0) {
+        return 0;
+      }
+      if (epptr() - pptr() < count) {
+        grow(static_cast<std::size_t>(pptr() - pbase() + count));
+      }
+      std::memcpy(pptr(), s, static_cast<std::size_t>(count));
+      advance(static_cast<std::size_t>(count));
+      return count;
+    }
+
+    void BufferStreamBuffer::grow(std::size_t minCapacity) {
+      auto size = static_cast<std::size_t>(pptr() - pbase());
+      storage.resize(std::max({minCapacity, storage.size() * 2, std::size_t{256}}));
+      setp(storage.data(), storage.data() + storage.size());
+      advance(size);
+    }
+
+    void BufferStreamBuffer::advance(std::size_t numBytes) {
+      // pbump() only takes an int, so advance in steps for huge buffers
+      while (numBytes) {
+        auto step = std::min<std::size_t>(numBytes, std::numeric_limits<int>::max());
+        pbump(static_cast<int>(step));
+        numBytes -= step;
+      }
+    }
+
+    void SpanStreamBuffer::reset(std::span<const std::byte> data) noexcept {
+      // the get area is never written to, since #pbackfail() is not overridden
+      auto* begin = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+      setg(begin, begin, begin + data.size());
+    }
+
+    SpanStreamBuffer::pos_type SpanStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                         std::ios_base::openmode which) {
+      if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+      }
+      off_type base = dir == std::ios_base::beg ? 0 : dir == std::ios_base::cur ? gptr() - eback() : egptr() - eback();
+      auto target = base + off;
+      if (target < 0 || target > egptr() - eback()) {
+        return pos_type(off_type(-1));
+      }
+      setg(eback(), eback() + target, egptr());
+      return pos_type(target);
+    }
+
+    SpanStreamBuffer::pos_type SpanStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which) {
+      return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+  } // namespace detail
+
+} // namespace serialize
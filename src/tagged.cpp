@@ -0,0 +1,48 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "tagged.hpp"
+
+#include "byte_packing.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace serialize {
+
+  namespace detail {
+    void writeTaggedField(std::ostream& out, uint32_t number, std::span<const std::byte> value) {
+      BytePackingSinkSerializer{out}.write(number);
+      writeFrame(out, value);
+    }
+
+    TaggedField nextTaggedField(std::span<const std::byte>& data) {
+      std::size_t position = 0;
+      BytePackingSourceDeserializer deserializer{[&data, &position](std::byte& byte) {
+        if (position >= data.size()) {
+          return false;
+        }
+        byte = data[position++];
+        return true;
+      }};
+      auto number = deserialize<uintmax_t>(deserializer);
+      auto size = deserialize<uintmax_t>(deserializer);
+      if (number > std::numeric_limits<uint32_t>::max()) {
+        throw std::domain_error{"Invalid field number " + std::to_string(number)};
+      }
+      if (size > data.size() - position) {
+        throw std::domain_error{"Size of field " + std::to_string(number) + " (" + std::to_string(size) +
+                                " bytes) exceeds the remaining record size of " +
+                                std::to_string(data.size() - position) + " bytes"};
+      }
+      TaggedField field{static_cast<uint32_t>(number), data.subspan(position, size)};
+      data = data.subspan(position + size);
+      return field;
+    }
+  } // namespace detail
+
+} // namespace serialize
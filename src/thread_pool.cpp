@@ -0,0 +1,100 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace serialize {
+
+  namespace {
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local std::size_t currentWorker = 0;
+  } // namespace
+
+  ThreadPool::ThreadPool(std::size_t numThreads) : nextWorker(0), numQueued(0), stopping(false) {
+    numThreads = std::max(numThreads, std::size_t{1});
+    workers.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+      workers.emplace_back(std::make_unique<Worker>());
+    }
+    threads.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back(&ThreadPool::run, this, i);
+    }
+  }
+
+  ThreadPool::~ThreadPool() noexcept {
+    {
+      std::lock_guard guard{mutex};
+      stopping = true;
+    }
+    condition.notify_all();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  void ThreadPool::submit(Task&& task) {
+    auto index = currentPool == this ? currentWorker : nextWorker.fetch_add(1) % workers.size();
+    {
+      // count the task only after it is queued successfully, but under the same lock as taking it from the queue to not
+      // underflow the counter when the task is immediately taken
+      std::lock_guard guard{workers[index]->mutex};
+      workers[index]->tasks.emplace_back(std::move(task));
+      ++numQueued;
+    }
+    {
+      // acquire the lock to not miss the wake-up of a worker which checked the counter and is just about to wait
+      std::lock_guard guard{mutex};
+    }
+    condition.notify_one();
+  }
+
+  void ThreadPool::run(std::size_t index) {
+    currentPool = this;
+    currentWorker = index;
+    while (true) {
+      Task task{};
+      if (tryPop(index, task) || trySteal(index, task)) {
+        task();
+        continue;
+      }
+      std::unique_lock lock{mutex};
+      condition.wait(lock, [this]() { return stopping || numQueued > 0; });
+      if (stopping && numQueued == 0) {
+        return;
+      }
+    }
+  }
+
+  bool ThreadPool::tryPop(std::size_t index, Task& task) {
+    auto& worker = *workers[index];
+    std::lock_guard guard{worker.mutex};
+    if (worker.tasks.empty()) {
+      return false;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    --numQueued;
+    return true;
+  }
+
+  bool ThreadPool::trySteal(std::size_t index, Task& task) {
+    for (std::size_t offset = 1; offset < workers.size(); ++offset) {
+      auto& victim = *workers[(index + offset) % workers.size()];
+      std::lock_guard guard{victim.mutex};
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        --numQueued;
+        return true;
+      }
+    }
+    return false;
+  }
+
+} // namespace serialize
@@ -12,6 +12,7 @@ namespace serialize {
   static_assert(Serializer<TypeSafeSerializer<SimpleStreamSerializer>>);
   static_assert(!ByteSerializer<TypeSafeSerializer<SimpleStreamSerializer>>);
   static_assert(Deserializer<TypeSafeDeserializer<SimpleStreamDeserializer>>);
+  static_assert(SkippingDeserializer<TypeSafeDeserializer<SimpleStreamDeserializer>>);
 
   namespace detail {
 
@@ -0,0 +1,82 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "allocation_tracking.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Every allocation is prefixed with its size to also track the deallocated bytes
+static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+static_assert(HEADER_SIZE >= sizeof(std::size_t));
+
+// Lock-free to not distort time measurements, allocations can happen on any thread
+static std::atomic_bool isTracking{false};
+static std::atomic_size_t numAllocations{0};
+static std::atomic_size_t numDeallocations{0};
+static std::atomic_size_t numBytes{0};
+static std::atomic_size_t currentBytes{0};
+static std::atomic_size_t peakBytes{0};
+
+// The allocation functions are defined in a separate translation unit to not inline them into their callers
+void* operator new(std::size_t size) {
+  auto* block = static_cast<std::byte*>(std::malloc(size + HEADER_SIZE));
+  if (!block) {
+    throw std::bad_alloc{};
+  }
+  std::memcpy(block, &size, sizeof(size));
+  if (isTracking.load(std::memory_order_relaxed)) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    numBytes.fetch_add(size, std::memory_order_relaxed);
+    auto current = currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    auto peak = peakBytes.load(std::memory_order_relaxed);
+    while (current > peak && !peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+  }
+  return block + HEADER_SIZE;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (!ptr) {
+    return;
+  }
+  auto* block = static_cast<std::byte*>(ptr) - HEADER_SIZE;
+  if (isTracking.load(std::memory_order_relaxed)) {
+    std::size_t size = 0;
+    std::memcpy(&size, block, sizeof(size));
+    numDeallocations.fetch_add(1, std::memory_order_relaxed);
+    // the memory might have been allocated before the tracking started
+    auto current = currentBytes.load(std::memory_order_relaxed);
+    while (!currentBytes.compare_exchange_weak(current, current - std::min(current, size), std::memory_order_relaxed)) {
+    }
+  }
+  std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t /* size */) noexcept { ::operator delete(ptr); }
+
+AllocationTracker::AllocationTracker() noexcept {
+  numAllocations.store(0, std::memory_order_relaxed);
+  numDeallocations.store(0, std::memory_order_relaxed);
+  numBytes.store(0, std::memory_order_relaxed);
+  currentBytes.store(0, std::memory_order_relaxed);
+  peakBytes.store(0, std::memory_order_relaxed);
+  isTracking.store(true, std::memory_order_seq_cst);
+}
+
+AllocationTracker::~AllocationTracker() noexcept { isTracking.store(false, std::memory_order_seq_cst); }
+
+AllocationStatistics AllocationTracker::statistics() const noexcept {
+  AllocationStatistics statistics{};
+  statistics.numAllocations = numAllocations.load(std::memory_order_relaxed);
+  statistics.numDeallocations = numDeallocations.load(std::memory_order_relaxed);
+  statistics.numBytes = numBytes.load(std::memory_order_relaxed);
+  statistics.peakBytes = peakBytes.load(std::memory_order_relaxed);
+  return statistics;
+}
@@ -0,0 +1,49 @@
+/*
+ * Tracking of heap allocations via replaced global allocation functions.
+ *
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Heap allocations done during the lifetime of an AllocationTracker.
+ */
+struct AllocationStatistics {
+  std::size_t numAllocations = 0;
+  std::size_t numDeallocations = 0;
+  /**
+   * The total number of bytes allocated.
+   */
+  std::size_t numBytes = 0;
+  /**
+   * The maximum number of bytes allocated and not yet deallocated at the same time.
+   */
+  std::size_t peakBytes = 0;
+};
+
+/**
+ * Tracks all heap allocations via the global operator new and operator delete functions during its lifetime.
+ *
+ * NOTE: Only available when linking allocation_tracking.cpp, which replaces the global allocation functions. This is
+ * used by both the allocation tests and the serialize_bench benchmark. Only a single tracker can be active at any time
+ * and allocations are tracked for all threads.
+ */
+class AllocationTracker {
+public:
+  AllocationTracker() noexcept;
+  AllocationTracker(const AllocationTracker&) = delete;
+  AllocationTracker(AllocationTracker&&) noexcept = delete;
+  ~AllocationTracker() noexcept;
+
+  AllocationTracker& operator=(const AllocationTracker&) = delete;
+  AllocationTracker& operator=(AllocationTracker&&) noexcept = delete;
+
+  /**
+   * Returns the allocations done since construction of this tracker.
+   */
+  AllocationStatistics statistics() const noexcept;
+};
@@ -0,0 +1,211 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "allocation_tracking.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "deserialize.hpp"
+#include "serialize.hpp"
+#include "simple.hpp"
+#include "streams.hpp"
+
+#include "cpptest-main.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace serialize;
+
+static const std::string LONG_STRING(100, 'x');
+
+struct AllocatingAggregate {
+  uint32_t id;
+  std::string name;
+  std::vector<uint16_t> values;
+  std::array<double, 4> factors;
+
+  auto operator<=>(const AllocatingAggregate& other) const noexcept = default;
+};
+
+struct NestedAggregate {
+  AllocatingAggregate first;
+  std::pair<int32_t, float> second;
+  std::string comment;
+
+  auto operator<=>(const NestedAggregate& other) const noexcept = default;
+};
+
+/**
+ * Checks the heap allocations of deserializing all supported type categories, i.e. that no unexpected temporary values
+ * are allocated.
+ */
+template <typename S, typename D> class TestAllocations : public Test::Suite {
+public:
+  explicit TestAllocations(const std::string& name) : Suite(name) {
+    TEST_ADD(TestAllocations::testFundamentals);
+    TEST_ADD(TestAllocations::testStrings);
+    TEST_ADD(TestAllocations::testVectors);
+    TEST_ADD(TestAllocations::testNodeContainers);
+    TEST_ADD(TestAllocations::testUniquePtr);
+    TEST_ADD(TestAllocations::testVariant);
+    TEST_ADD(TestAllocations::testOptional);
+    TEST_ADD(TestAllocations::testTuples);
+    TEST_ADD(TestAllocations::testAggregates);
+  }
+
+  void testFundamentals() {
+    checkNoAllocations(uint64_t{0x123456789});
+    checkNoAllocations(-17.5);
+    checkNoAllocations(std::bitset<100>{}.set(42));
+    checkNoAllocations(std::chrono::milliseconds{1234});
+    checkNoAllocations(std::array<int16_t, 16>{1, -2, 3});
+  }
+
+  void testStrings() {
+    // small string optimization
+    checkNoAllocations(std::string{"foo"});
+    auto stats = checkDeserialize(LONG_STRING);
+    testAssertEquals(1U, stats.numAllocations);
+    // the exact capacity of the string depends on the standard library implementation
+    testAssert(stats.numBytes > LONG_STRING.size());
+  }
+
+  void testVectors() {
+    std::vector<int32_t> numbers(1000, -42);
+    auto stats = checkDeserialize(numbers);
+    // reserved up-front
+    testAssertEquals(1U, stats.numAllocations);
+    testAssertEquals(numbers.size() * sizeof(int32_t), stats.numBytes);
+    testAssertEquals(stats.numBytes, stats.peakBytes);
+
+    std::vector<std::string> strings(10, LONG_STRING);
+    stats = checkDeserialize(strings);
+    // no temporary copies of the elements
+    testAssertEquals(1U + strings.size(), stats.numAllocations);
+    testAssertEquals(0U, stats.numDeallocations);
+    testAssertEquals(stats.numBytes, stats.peakBytes);
+  }
+
+  void testNodeContainers() {
+    std::list<uint32_t> list{1, 2, 3, 4, 5};
+    testAssertEquals(list.size(), checkDeserialize(list).numAllocations);
+
+    std::set<int64_t> set{-1, 0, 1, 1000, -1000};
+    testAssertEquals(set.size(), checkDeserialize(set).numAllocations);
+
+    std::map<uint32_t, std::string> map{{1, "one"}, {2, "two"}, {3, LONG_STRING}};
+    auto stats = checkDeserialize(map);
+    testAssertEquals(map.size() + 1, stats.numAllocations);
+    testAssertEquals(0U, stats.numDeallocations);
+
+    std::unordered_set<uint32_t> hashSet{1, 2, 3, 4, 5, 6, 7, 8};
+    stats = checkDeserialize(hashSet);
+    // the nodes and a single reserved bucket array
+    testAssertEquals(hashSet.size() + 1, stats.numAllocations);
+    testAssertEquals(0U, stats.numDeallocations);
+  }
+
+  void testUniquePtr() {
+    checkNoAllocations(std::unique_ptr<uint32_t>{});
+    auto stats = checkDeserialize(std::make_unique<uint32_t>(17));
+    testAssertEquals(1U, stats.numAllocations);
+    testAssertEquals(sizeof(uint32_t), stats.numBytes);
+
+    stats = checkDeserialize(std::make_unique<std::string>(LONG_STRING));
+    testAssertEquals(2U, stats.numAllocations);
+  }
+
+  void testVariant() {
+    using Variant = std::variant<uint32_t, std::string, std::vector<double>>;
+    checkNoAllocations(Variant{17U});
+    checkNoAllocations(Variant{std::string{"foo"}});
+    testAssertEquals(1U, checkDeserialize(Variant{LONG_STRING}).numAllocations);
+    testAssertEquals(1U, checkDeserialize(Variant{std::vector<double>{1.0, 2.0}}).numAllocations);
+  }
+
+  void testOptional() {
+    checkNoAllocations(std::optional<uint32_t>{});
+    checkNoAllocations(std::optional<uint32_t>{42});
+    auto stats = checkDeserialize(std::optional<std::string>{LONG_STRING});
+    testAssertEquals(1U, stats.numAllocations);
+    testAssertEquals(0U, stats.numDeallocations);
+  }
+
+  void testTuples() {
+    checkNoAllocations(std::make_pair(uint8_t{1}, 2.0f));
+    testAssertEquals(1U, checkDeserialize(std::make_tuple(LONG_STRING, int64_t{-1}, 'c')).numAllocations);
+    testAssertEquals(2U, checkDeserialize(std::make_pair(LONG_STRING, LONG_STRING)).numAllocations);
+  }
+
+  void testAggregates() {
+    AllocatingAggregate aggregate{17, LONG_STRING, {1, 2, 3}, {1.0, 2.0, 3.0, 4.0}};
+    auto stats = checkDeserialize(aggregate);
+    // members are deserialized in-place via forEachMember
+    testAssertEquals(2U, stats.numAllocations);
+    testAssertEquals(0U, stats.numDeallocations);
+
+    NestedAggregate nested{aggregate, {-1, 0.5f}, LONG_STRING};
+    stats = checkDeserialize(nested);
+    testAssertEquals(3U, stats.numAllocations);
+    testAssertEquals(0U, stats.numDeallocations);
+  }
+
+private:
+  template <typename T> static std::vector<std::byte> serializeValue(const T& value) {
+    BufferOutputStream out{};
+    S s{out};
+    serialize::serialize(s, value);
+    s.flush();
+    return std::vector<std::byte>(out.data().begin(), out.data().end());
+  }
+
+  template <typename T> AllocationStatistics checkDeserialize(const T& value) {
+    auto data = serializeValue(value);
+    SpanInputStream in{data};
+    D d{in};
+    std::optional<T> result{};
+    AllocationStatistics stats{};
+    {
+      AllocationTracker tracker{};
+      result.emplace(deserialize<T>(d));
+      stats = tracker.statistics();
+    }
+    if constexpr (requires { *value; }) {
+      testAssertEquals(static_cast<bool>(value), static_cast<bool>(*result));
+      if (value) {
+        testAssertEquals(*value, **result);
+      }
+    } else {
+      testAssertEquals(value, *result);
+    }
+    return stats;
+  }
+
+  template <typename T> void checkNoAllocations(const T& value) {
+    auto stats = checkDeserialize(value);
+    testAssertEquals(0U, stats.numAllocations);
+    testAssertEquals(0U, stats.peakBytes);
+  }
+};
+
+int main(int argc, char** argv) {
+  registerBackendSuites<TestAllocations>("allocations", "Allocations");
+  return Test::runSuites(argc, argv);
+}
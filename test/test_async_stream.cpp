@@ -0,0 +1,214 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "async_stream.hpp"
+
+#include "bit_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+class FailingStreamBuffer : public std::streambuf {
+protected:
+  int_type overflow(int_type /* ch */) override { return traits_type::eof(); }
+  int_type underflow() override { throw std::runtime_error{"Read error"}; }
+};
+
+class TestAsyncStream : public Test::Suite {
+public:
+  TestAsyncStream() : Suite("AsyncStream") {
+    TEST_ADD(TestAsyncStream::testWriteToStream);
+    TEST_ADD(TestAsyncStream::testFlushPersistsData);
+    TEST_ADD(TestAsyncStream::testSmallBuffers);
+    TEST_ADD(TestAsyncStream::testWriteToFileDescriptor);
+    TEST_ADD(TestAsyncStream::testWriteError);
+    TEST_ADD(TestAsyncStream::testReadFromStream);
+    TEST_ADD(TestAsyncStream::testReadSmallBuffers);
+    TEST_ADD(TestAsyncStream::testReadFromFileDescriptor);
+    TEST_ADD(TestAsyncStream::testReadEmpty);
+    TEST_ADD(TestAsyncStream::testReadError);
+  }
+
+  void testWriteToStream() {
+    auto values = createValues(10000);
+    std::stringstream expected{};
+    {
+      BitPackingSinkSerializer s{expected};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+
+    std::stringstream ss{};
+    {
+      AsyncOutputStream out{ss, 256};
+      BitPackingSinkSerializer s{out};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+    testAssertEquals(expected.str(), ss.str());
+
+    BitPackingSourceDeserializer d{ss};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+  }
+
+  void testFlushPersistsData() {
+    std::stringstream ss{};
+    AsyncOutputStream out{ss, 64, 3};
+    SimpleStreamSerializer s{out};
+    serialize::serialize(s, std::string{"Hello World"});
+    testAssert(out.flush().good());
+    testAssertEquals(sizeof(std::size_t) + 11U, ss.str().size());
+
+    serialize::serialize(s, uint32_t{42});
+    out << std::flush;
+    testAssert(out.good());
+    testAssertEquals(sizeof(std::size_t) + 11U + sizeof(uint32_t), ss.str().size());
+
+    // flushing without new data does not change anything
+    testAssert(out.flush().good());
+    testAssertEquals(sizeof(std::size_t) + 11U + sizeof(uint32_t), ss.str().size());
+  }
+
+  void testSmallBuffers() {
+    std::vector<uint64_t> values(4096);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] = i * 0x0101010101010101ULL;
+    }
+    std::stringstream ss{};
+    {
+      // minimum buffer sizes, every byte is handed over separately
+      AsyncOutputStream out{ss, 1, 1};
+      SimpleStreamSerializer s{out};
+      serialize::serialize(s, values);
+    }
+
+    SimpleStreamDeserializer d{ss};
+    testAssertEquals(values, deserialize<std::vector<uint64_t>>(d));
+  }
+
+  void testWriteToFileDescriptor() {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file{std::tmpfile(), &std::fclose};
+    testAssert(file != nullptr);
+    auto values = createValues(1000);
+    {
+      AsyncOutputStream out{fileno(file.get()), 512};
+      SimpleStreamSerializer s{out};
+      serialize::serialize(s, values);
+      testAssert(out.flush().good());
+    }
+
+    std::rewind(file.get());
+    std::string contents{};
+    std::vector<char> buffer(4096);
+    while (auto numRead = std::fread(buffer.data(), 1, buffer.size(), file.get())) {
+      contents.append(buffer.data(), numRead);
+    }
+    std::stringstream ss{contents};
+    SimpleStreamDeserializer d{ss};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+  }
+
+  void testWriteError() {
+    FailingStreamBuffer buffer{};
+    std::ostream sink{&buffer};
+    AsyncOutputStream out{sink, 16};
+    SimpleStreamSerializer s{out};
+    serialize::serialize(s, std::string{"Some string longer than the buffer size"});
+    out.flush();
+    testAssert(out.bad());
+  }
+
+  void testReadFromStream() {
+    auto values = createValues(10000);
+    std::stringstream ss{};
+    {
+      BitPackingSinkSerializer s{ss};
+      serialize::serialize(s, values);
+      serialize::serialize(s, 42U);
+      s.flush();
+    }
+
+    AsyncInputStream in{ss, 256};
+    BitPackingSourceDeserializer d{in};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+    testAssertEquals(42U, deserialize<unsigned>(d));
+    testThrows<std::out_of_range>([&] { deserialize<unsigned>(d); });
+  }
+
+  void testReadSmallBuffers() {
+    std::vector<uint64_t> values(4096);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] = i * 0x0101010101010101ULL;
+    }
+    std::stringstream ss{};
+    {
+      SimpleStreamSerializer s{ss};
+      serialize::serialize(s, values);
+    }
+
+    // minimum buffer sizes, every byte is handed over separately
+    AsyncInputStream in{ss, 1, 1};
+    SimpleStreamDeserializer d{in};
+    testAssertEquals(values, deserialize<std::vector<uint64_t>>(d));
+  }
+
+  void testReadFromFileDescriptor() {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file{std::tmpfile(), &std::fclose};
+    testAssert(file != nullptr);
+    auto values = createValues(1000);
+    {
+      std::stringstream ss{};
+      SimpleStreamSerializer s{ss};
+      serialize::serialize(s, values);
+      auto contents = ss.str();
+      testAssertEquals(contents.size(), std::fwrite(contents.data(), 1, contents.size(), file.get()));
+      std::fflush(file.get());
+      std::rewind(file.get());
+    }
+
+    AsyncInputStream in{fileno(file.get()), 512};
+    SimpleStreamDeserializer d{in};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+    testAssert(in.peek() == std::char_traits<char>::eof());
+  }
+
+  void testReadEmpty() {
+    std::stringstream ss{};
+    AsyncInputStream in{ss};
+    testAssert(in.get() == std::char_traits<char>::eof());
+    testAssert(in.eof());
+  }
+
+  void testReadError() {
+    FailingStreamBuffer buffer{};
+    std::istream source{&buffer};
+    AsyncInputStream in{source, 16};
+    SimpleStreamDeserializer d{in};
+    testThrows<std::out_of_range>([&] { deserialize<uint32_t>(d); });
+    testAssert(in.bad());
+  }
+
+private:
+  static std::vector<std::string> createValues(std::size_t numValues) {
+    std::vector<std::string> values{};
+    for (std::size_t i = 0; i < numValues; ++i) {
+      values.push_back("Value #" + std::to_string(i * 31));
+    }
+    return values;
+  }
+};
+
+void registerAsyncStreamTests() { Test::registerSuite(Test::newInstance<TestAsyncStream>, "async-stream"); }
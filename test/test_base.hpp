@@ -5,8 +5,12 @@
  */
 #pragma once
 
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
 #include "deserialize.hpp"
 #include "serialize.hpp"
+#include "simple.hpp"
+#include "skip.hpp"
 #include "traits.hpp"
 
 #include "cpptest-main.h"
@@ -58,6 +62,23 @@ static_assert(std::is_trivial_v<FundamentalTypes>);
 static_assert(serialize::Serializable<FundamentalTypes>);
 static_assert(serialize::Deserializable<FundamentalTypes>);
 
+/**
+ * Aggregate with the maximum supported number of members.
+ */
+struct LargeAggregate {
+  uint8_t u0, u1, u2, u3, u4, u5, u6, u7, u8, u9, u10, u11, u12, u13, u14, u15;
+  int32_t i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15;
+  uint64_t l0, l1, l2, l3, l4, l5, l6, l7, l8, l9, l10, l11, l12, l13, l14, l15;
+  double d0, d1, d2, d3, d4, d5, d6, d7, d8, d9, d10, d11, d12, d13, d14, d15;
+
+  constexpr auto operator<=>(const LargeAggregate& other) const noexcept = default;
+};
+
+static_assert(serialize::detail::memberCount<LargeAggregate> == serialize::detail::MAX_MEMBER_COUNT);
+static_assert(serialize::detail::memberCount<FundamentalTypes> == 17);
+static_assert(serialize::Serializable<LargeAggregate>);
+static_assert(serialize::Deserializable<LargeAggregate>);
+
 struct UserDefinedMemberSerialization {
   UserDefinedMemberSerialization() = default;
   UserDefinedMemberSerialization(const UserDefinedMemberSerialization&) = delete;
@@ -124,13 +145,16 @@ protected:
     TEST_ADD(SerializationTestBase::testArrayOfFloats);
     TEST_ADD(SerializationTestBase::testVectorOfIntegers);
     TEST_ADD(SerializationTestBase::testVectorOfStrings);
+    TEST_ADD(SerializationTestBase::testBitContainers);
     TEST_ADD(SerializationTestBase::testMap);
     TEST_ADD(SerializationTestBase::testTrivialUserDefinedType);
+    TEST_ADD(SerializationTestBase::testLargeUserDefinedType);
     TEST_ADD(SerializationTestBase::testMemberSerializationFunctions);
     TEST_ADD(SerializationTestBase::testStaticMemberSerializationFunctions);
     TEST_ADD(SerializationTestBase::testSpecialStdTypes);
     TEST_ADD(SerializationTestBase::testMultiValue);
     TEST_ADD(SerializationTestBase::testThrowOnEof);
+    TEST_ADD(SerializationTestBase::testSkip);
     TEST_ADD(SerializationTestBase::reportBufferSizes);
   }
 
@@ -191,6 +215,41 @@ protected:
     }
   }
 
+  void testBitContainers() {
+    // spans multiple chunks of packed bits
+    std::bitset<5001> largeBits{};
+    for (std::size_t size : {0, 1, 8, 63, 64, 65, 5001}) {
+      std::vector<bool> bits(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        bits[i] = i % 3 == 0 || i % 7 == 1;
+        largeBits.set(i, bits[i]);
+      }
+      std::stringstream data{};
+      auto [serializer, deserializer] = createSerializerAndDeserializer(data);
+      serialize::serialize(serializer, bits);
+      serializer.flush();
+      totalBufferSize += getBufferSize(data);
+      testAssertEquals(bits, serialize::deserialize<std::vector<bool>>(deserializer));
+    }
+
+    std::stringstream data{};
+    auto [serializer, deserializer] = createSerializerAndDeserializer(data);
+    std::bitset<1024> fullBytes{};
+    fullBytes.set(0).set(511).set(1023);
+    serialize::serialize(serializer, largeBits);
+    serialize::serialize(serializer, fullBytes);
+    serializer.flush();
+    totalBufferSize += getBufferSize(data);
+    auto result = serialize::deserialize<decltype(largeBits)>(deserializer);
+    testAssertEquals(largeBits.count(), result.count());
+    testAssertEquals(largeBits, result);
+    testAssertEquals(fullBytes, serialize::deserialize<decltype(fullBytes)>(deserializer));
+
+    if (hasFailed()) {
+      testAssertEquals("", toSerializedDataString(data));
+    }
+  }
+
   void testMap() {
     std::stringstream data{};
     auto [serializer, deserializer] = createSerializerAndDeserializer(data);
@@ -251,6 +310,29 @@ protected:
     }
   }
 
+  void testLargeUserDefinedType() {
+    LargeAggregate input{};
+    input.u0 = 17;
+    input.u15 = 255;
+    input.i3 = -123456;
+    input.i12 = 42;
+    input.l7 = uint64_t{1} << 40;
+    input.d0 = -0.5;
+    input.d15 = 1e300;
+
+    std::stringstream data{};
+    auto [serializer, deserializer] = createSerializerAndDeserializer(data);
+    serialize::serialize(serializer, input);
+    serializer.flush();
+    totalBufferSize += getBufferSize(data);
+    auto result = serialize::deserialize<LargeAggregate>(deserializer);
+    testAssert(result == input);
+
+    if (hasFailed()) {
+      testAssertEquals("", toSerializedDataString(data));
+    }
+  }
+
   void testMemberSerializationFunctions() {
     UserDefinedMemberSerialization input{};
     input.storage = "Foo bar";
@@ -561,6 +643,54 @@ protected:
     }
   }
 
+  void testSkip() {
+    std::stringstream data{};
+    auto [serializer, deserializer] = createSerializerAndDeserializer(data);
+
+    std::optional<std::string> input0{"Foo"};
+    std::variant<double, std::string> input1{"Bar"};
+    std::bitset<267> input2{0b010101010101010101010101010010101010100101};
+    std::unique_ptr<std::string> input3{};
+    std::tuple<int, std::string, double> input4{17, "Baz", -42.42};
+    std::chrono::microseconds input5{42};
+    std::vector<bool> input6{true, false, false, true, true, false, true, true, true, false, true};
+
+    serialize::serialize(serializer, SOME_NUMBERS);
+    serialize::serialize(serializer, int32_t{17});
+    serialize::serialize(serializer, SOME_STRINGS);
+    serialize::serialize(serializer, SOME_MAP);
+    serialize::serialize(serializer, SOME_ARRAY);
+    serialize::serialize(serializer, FUNDAMENTAL_TYPES);
+    serialize::serialize(serializer, input0);
+    serialize::serialize(serializer, input1);
+    serialize::serialize(serializer, input2);
+    serialize::serialize(serializer, input3);
+    serialize::serialize(serializer, input4);
+    serialize::serialize(serializer, input5);
+    serialize::serialize(serializer, input6);
+    serialize::serialize(serializer, SOME_STRINGS.back());
+    serializer.flush();
+
+    serialize::skip<std::remove_cv_t<decltype(SOME_NUMBERS)>>(deserializer);
+    testAssertEquals(int32_t{17}, serialize::deserialize<int32_t>(deserializer));
+    serialize::skip<std::remove_cv_t<decltype(SOME_STRINGS)>>(deserializer);
+    serialize::skip<std::remove_cv_t<decltype(SOME_MAP)>>(deserializer);
+    serialize::skip<std::remove_cv_t<decltype(SOME_ARRAY)>>(deserializer);
+    serialize::skip<std::remove_cv_t<decltype(FUNDAMENTAL_TYPES)>>(deserializer);
+    serialize::skip<decltype(input0)>(deserializer);
+    serialize::skip<decltype(input1)>(deserializer);
+    serialize::skip<decltype(input2)>(deserializer);
+    serialize::skip<decltype(input3)>(deserializer);
+    serialize::skip<decltype(input4)>(deserializer);
+    serialize::skip<decltype(input5)>(deserializer);
+    serialize::skip<decltype(input6)>(deserializer);
+    testAssertEquals(SOME_STRINGS.back(), serialize::deserialize<std::string>(deserializer));
+
+    if (hasFailed()) {
+      testAssertEquals("", toSerializedDataString(data));
+    }
+  }
+
   void reportBufferSizes() {
     std::cout << "Total serialization bytes used by '" << getName() << "': " << totalBufferSize << std::endl;
   }
@@ -632,3 +762,28 @@ protected:
 private:
   std::size_t totalBufferSize = 0;
 };
+
+/**
+ * Registers the given test suite template for the Simple, BitPacking and BytePacking backends as "<name>-simple",
+ * "<name>-bit-packing" and "<name>-byte-packing". The suites are constructed with the given suite name followed by the
+ * backend, e.g. "LossySimple".
+ */
+template <template <typename, typename> class TestSuite>
+void registerBackendSuites(const std::string& name, const std::string& suiteName) {
+  using namespace serialize;
+  Test::registerSuite(
+      [suiteName]() -> Test::Suite* {
+        return new TestSuite<SimpleStreamSerializer, SimpleStreamDeserializer>(suiteName + "Simple");
+      },
+      name + "-simple");
+  Test::registerSuite(
+      [suiteName]() -> Test::Suite* {
+        return new TestSuite<BitPackingSinkSerializer, BitPackingSourceDeserializer>(suiteName + "BitPacking");
+      },
+      name + "-bit-packing");
+  Test::registerSuite(
+      [suiteName]() -> Test::Suite* {
+        return new TestSuite<BytePackingSinkSerializer, BytePackingSourceDeserializer>(suiteName + "BytePacking");
+      },
+      name + "-byte-packing");
+}
@@ -0,0 +1,143 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "bounded.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+#include "streams.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace serialize;
+
+struct OrderMessage {
+  uint64_t orderId;
+  int64_t price;
+  uint32_t quantity;
+  char side;
+  bool immediateOrCancel;
+  std::array<char, 8> symbol;
+  std::bitset<12> flags;
+  std::pair<uint16_t, int8_t> venue;
+
+  auto operator<=>(const OrderMessage& other) const noexcept = default;
+};
+
+static_assert(maxSerializedSize<SimpleStreamSerializer, uint32_t> == 4);
+static_assert(maxSerializedSize<BytePackingSinkSerializer, uint64_t> == 10);
+static_assert(maxSerializedSize<BytePackingSinkSerializer, uint8_t> == 2);
+static_assert(maxSerializedSize<SimpleStreamSerializer, std::optional<uint32_t>> == 5);
+static_assert(maxSerializedSize<SimpleStreamSerializer, std::variant<int8_t, double>> == sizeof(std::size_t) + 8);
+static_assert(BoundedSerializable<OrderMessage, BitPackingSinkSerializer>);
+static_assert(!BoundedSerializable<std::string, SimpleStreamSerializer>);
+static_assert(!BoundedSerializable<std::vector<uint32_t>, BytePackingSinkSerializer>);
+static_assert(!BoundedSerializable<std::pair<uint32_t, std::string>, BitPackingSinkSerializer>);
+
+template <typename S, typename D> class TestBounded : public Test::Suite {
+public:
+  explicit TestBounded(const std::string& name) : Suite(name) {
+    TEST_ADD(TestBounded::testEncode);
+    TEST_ADD(TestBounded::testWorstCase);
+    TEST_ADD(TestBounded::testExtremeValues);
+    TEST_ADD(TestBounded::testReuse);
+  }
+
+  void testEncode() {
+    OrderMessage order{12345, -995, 100, 'B', true, {'A', 'C', 'M', 'E'}, 0xA5A, {17, -3}};
+    StackEncoder<S, OrderMessage> encoder{};
+    auto data = encoder.encode(order);
+    testAssert(data.size() <= encoder.CAPACITY);
+    testAssert(std::ranges::equal(data, encodeStream(order)));
+    testAssertEquals(order, decode(data));
+  }
+
+  void testWorstCase() {
+    OrderMessage order{std::numeric_limits<uint64_t>::max(),
+                       std::numeric_limits<int64_t>::min(),
+                       std::numeric_limits<uint32_t>::max(),
+                       std::numeric_limits<char>::min(),
+                       true,
+                       {'\x7F', '\x7F', '\x7F', '\x7F', '\x7F', '\x7F', '\x7F', '\x7F'},
+                       0xFFF,
+                       {std::numeric_limits<uint16_t>::max(), std::numeric_limits<int8_t>::min()}};
+    StackEncoder<S, OrderMessage> encoder{};
+    auto data = encoder.encode(order);
+    testAssert(data.size() <= encoder.CAPACITY);
+    testAssertEquals(order, decode(data));
+  }
+
+  void testExtremeValues() {
+    checkExtremeValue(std::numeric_limits<uint64_t>::max());
+    checkExtremeValue(std::numeric_limits<int64_t>::min());
+    checkExtremeValue(std::numeric_limits<int64_t>::max());
+    // NaN with all bits set, which is also the bit-reversed value written by the bit packing
+    checkExtremeValue(std::bit_cast<float>(std::numeric_limits<uint32_t>::max()));
+    checkExtremeValue(std::bit_cast<double>(std::numeric_limits<uint64_t>::max()));
+    std::array<std::byte, sizeof(long double)> allOnes{};
+    allOnes.fill(std::byte{0xFF});
+    checkExtremeValue(std::bit_cast<long double>(allOnes));
+  }
+
+  void testReuse() {
+    StackEncoder<S, std::variant<uint8_t, std::array<int32_t, 4>>> encoder{};
+    testAssertEquals(0U, encoder.data().size());
+    auto first = encoder.encode(std::array<int32_t, 4>{1, -2, 3, -4});
+    std::vector<std::byte> firstData(first.begin(), first.end());
+    auto second = encoder.encode(uint8_t{42});
+    testAssert(second.size() <= firstData.size());
+    testAssert(std::ranges::equal(second, encodeStream(std::variant<uint8_t, std::array<int32_t, 4>>{uint8_t{42}})));
+  }
+
+private:
+  template <typename T> void checkExtremeValue(T value) {
+    StackEncoder<S, T> encoder{};
+    auto data = encoder.encode(value);
+    testAssert(data.size() <= encoder.CAPACITY);
+    testAssert(std::ranges::equal(data, encodeStream(value)));
+    SpanInputStream in{data};
+    D d{in};
+    auto result = deserialize<T>(d);
+    if constexpr (std::is_same_v<T, long double>) {
+      // copying the value does not necessarily preserve the padding bits
+      testAssert(std::isnan(result));
+    } else {
+      // compare the bits to also support NaN values
+      testAssert(std::memcmp(&value, &result, sizeof(T)) == 0);
+    }
+  }
+
+  template <typename T> std::vector<std::byte> encodeStream(const T& value) {
+    BufferOutputStream out{};
+    S s{out};
+    serialize::serialize(s, value);
+    s.flush();
+    return std::vector<std::byte>(out.data().begin(), out.data().end());
+  }
+
+  OrderMessage decode(std::span<const std::byte> data) {
+    SpanInputStream in{data};
+    D d{in};
+    return deserialize<OrderMessage>(d);
+  }
+};
+
+void registerBoundedTests() { registerBackendSuites<TestBounded>("bounded", "Bounded"); }
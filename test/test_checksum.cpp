@@ -0,0 +1,195 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "checksum.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "compression.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+template <typename S, typename D> class TestChecksum : public Test::Suite {
+public:
+  explicit TestChecksum(const std::string& name) : Suite(name) {
+    TEST_ADD(TestChecksum::testCrc32c);
+    TEST_ADD(TestChecksum::testRoundTrip);
+    TEST_ADD(TestChecksum::testSmallBlocks);
+    TEST_ADD(TestChecksum::testSkipValues);
+    TEST_ADD(TestChecksum::testCorruptedPayload);
+    TEST_ADD(TestChecksum::testCorruptedChecksum);
+    TEST_ADD(TestChecksum::testCorruptedBlockSize);
+    TEST_ADD(TestChecksum::testLargeBlocks);
+    TEST_ADD(TestChecksum::testTruncatedData);
+    TEST_ADD(TestChecksum::testCompressedChecksummedStream);
+  }
+
+  void testCrc32c() {
+    // check values from RFC 3720, section B.4
+    std::array<std::byte, 32> zeroes{};
+    testAssertEquals(0x8A9136AAU, detail::crc32c(zeroes));
+    testAssertEquals(0x8A9136AAU, detail::crc32cSoftware(zeroes));
+    std::array<std::byte, 32> ones{};
+    ones.fill(std::byte{0xFF});
+    testAssertEquals(0x62A8AB43U, detail::crc32c(ones));
+    testAssertEquals(0x62A8AB43U, detail::crc32cSoftware(ones));
+    std::array<std::byte, 32> increasing{};
+    for (std::size_t i = 0; i < increasing.size(); ++i) {
+      increasing[i] = static_cast<std::byte>(i);
+    }
+    testAssertEquals(0x46DD794EU, detail::crc32c(increasing));
+    testAssertEquals(0x46DD794EU, detail::crc32cSoftware(increasing));
+
+    std::string text{"123456789"};
+    auto data = std::as_bytes(std::span{text});
+    testAssertEquals(0xE3069283U, detail::crc32c(data));
+    testAssertEquals(0xE3069283U, detail::crc32cSoftware(data));
+    // continued checksums
+    testAssertEquals(0xE3069283U, detail::crc32c(data.subspan(5), detail::crc32c(data.first(5))));
+    testAssertEquals(0U, detail::crc32c({}));
+  }
+
+  void testRoundTrip() {
+    auto values = createValues(5000);
+    std::stringstream ss{};
+    {
+      ChecksummedSerializer<S> s{ss};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+
+    ChecksummedDeserializer<D> d{ss};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+  }
+
+  void testSmallBlocks() {
+    auto values = createValues(100);
+    std::stringstream ss{};
+    {
+      ChecksummedSerializer<S> s{ss, 3};
+      serialize::serialize(s, values);
+      serialize::serialize(s, 17U);
+      // not flushed, written on destruction
+    }
+
+    ChecksummedDeserializer<D> d{ss};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+    testAssertEquals(17U, deserialize<unsigned>(d));
+  }
+
+  void testSkipValues() {
+    std::stringstream ss{};
+    {
+      ChecksummedSerializer<S> s{ss, 128};
+      serialize::serialize(s, createValues(500));
+      serialize::serialize(s, std::string{"Tail"});
+      s.flush();
+    }
+
+    ChecksummedDeserializer<D> d{ss};
+    skip<std::vector<std::string>>(d);
+    testAssertEquals(std::string{"Tail"}, deserialize<std::string>(d));
+  }
+
+  void testCorruptedPayload() {
+    auto data = writeValues(1000, 256);
+    // flip a single bit in the middle of the data
+    data[data.size() / 2] = static_cast<char>(data[data.size() / 2] ^ 0x10);
+    std::stringstream corrupted{data};
+
+    ChecksummedDeserializer<D> d{corrupted};
+    testThrows<std::domain_error>([&] { deserialize<std::vector<std::string>>(d); });
+  }
+
+  void testCorruptedChecksum() {
+    auto data = writeValues(10, 1024);
+    // the block size takes up 1 or 2 bytes, followed by the checksum
+    data[2] = static_cast<char>(data[2] ^ 0x01);
+    std::stringstream corrupted{data};
+
+    ChecksummedDeserializer<D> d{corrupted};
+    // the data is not passed to the wrapped deserializer at all
+    testThrows<std::domain_error>([&] { deserialize<std::size_t>(d); });
+  }
+
+  void testCorruptedBlockSize() {
+    auto data = writeValues(10, 1024);
+    // replace the variable-length block size with a huge value
+    std::size_t sizeLength = 1;
+    while (static_cast<unsigned char>(data[sizeLength - 1]) & 0x80) {
+      ++sizeLength;
+    }
+    std::stringstream corrupted{std::string{"\xFF\xFF\xFF\xFF\xFF\x0F"} + data.substr(sizeLength)};
+
+    ChecksummedDeserializer<D> d{corrupted};
+    testThrows<std::domain_error>([&] { deserialize<std::vector<std::string>>(d); });
+  }
+
+  void testLargeBlocks() {
+    constexpr std::size_t BLOCK_SIZE = 4 * ChecksummedOutputStream::DEFAULT_BLOCK_SIZE;
+    auto data = writeValues(50000, BLOCK_SIZE);
+    {
+      std::stringstream ss{data};
+      ChecksummedDeserializer<D> d{ss};
+      testThrows<std::domain_error>([&] { deserialize<std::vector<std::string>>(d); });
+    }
+    std::stringstream ss{data};
+    ChecksummedDeserializer<D> d{ss, BLOCK_SIZE};
+    testAssertEquals(createValues(50000), deserialize<std::vector<std::string>>(d));
+  }
+
+  void testTruncatedData() {
+    auto data = writeValues(1000, 256);
+    std::stringstream truncated{data.substr(0, data.size() - 7)};
+
+    ChecksummedDeserializer<D> d{truncated};
+    testThrows<std::out_of_range>([&] { deserialize<std::vector<std::string>>(d); });
+  }
+
+  void testCompressedChecksummedStream() {
+    auto values = createValues(5000);
+    std::stringstream ss{};
+    {
+      ChecksummedOutputStream checksummed{ss};
+      CompressedSerializer<S> s{checksummed};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+
+    ChecksummedInputStream checksummed{ss};
+    CompressedDeserializer<D> d{checksummed};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+  }
+
+private:
+  static std::vector<std::string> createValues(std::size_t numValues) {
+    std::vector<std::string> values{};
+    for (std::size_t i = 0; i < numValues; ++i) {
+      values.push_back("Value #" + std::to_string(i * 31));
+    }
+    return values;
+  }
+
+  static std::string writeValues(std::size_t numValues, std::size_t blockSize) {
+    std::stringstream ss{};
+    ChecksummedSerializer<S> s{ss, blockSize};
+    serialize::serialize(s, createValues(numValues));
+    s.flush();
+    return ss.str();
+  }
+};
+
+void registerChecksumTests() { registerBackendSuites<TestChecksum>("checksum", "Checksum"); }
@@ -0,0 +1,164 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "codec.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "fixed_buffer.hpp"
+#include "simple.hpp"
+#include "streams.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace serialize;
+
+struct CodecLevel {
+  int32_t price;
+  uint32_t quantity;
+
+  auto operator<=>(const CodecLevel& other) const noexcept = default;
+};
+
+struct CodecHeader {
+  uint64_t sequence;
+  uint32_t timestamp;
+  std::array<char, 4> venue;
+
+  auto operator<=>(const CodecHeader& other) const noexcept = default;
+};
+
+struct CodecBook {
+  CodecHeader header;
+  std::array<CodecLevel, 3> bids;
+  std::pair<uint16_t, double> limits;
+  std::string symbol;
+  std::vector<uint32_t> trades;
+  std::array<std::string, 2> notes;
+  bool closed;
+
+  auto operator<=>(const CodecBook& other) const noexcept = default;
+};
+
+// header and bids (as raw memory) + limits | symbol | trades | notes (constant size) | closed
+static_assert(CompiledCodec<SimpleStreamSerializer, CodecBook>::NUM_OPERATIONS == 12);
+static_assert(CompiledCodec<SimpleStreamSerializer, CodecBook>::NUM_BLOCKS == 3);
+// all members flattened into single elements
+static_assert(CompiledCodec<BytePackingSinkSerializer, CodecBook>::NUM_OPERATIONS == 22);
+static_assert(CompiledCodec<BytePackingSinkSerializer, CodecBook>::NUM_BLOCKS == 0);
+static_assert(CompiledCodec<FixedBufferSerializer<256>, CodecHeader>::NUM_BLOCKS == 1);
+
+static CodecBook createBook() {
+  return CodecBook{{123456789, 42, {'X', 'N', 'A', 'S'}},
+                   {{{100, 7}, {99, 12}, {-1, 0}}},
+                   {17, 0.25},
+                   "ACME",
+                   {1, 2, 3},
+                   {"first", ""},
+                   true};
+}
+
+template <typename S, typename D> class TestCodec : public Test::Suite {
+public:
+  explicit TestCodec(const std::string& name) : Suite(name) {
+    TEST_ADD(TestCodec::testGenericCompatibility);
+    TEST_ADD(TestCodec::testRoundTrip);
+    TEST_ADD(TestCodec::testFundamental);
+    TEST_ADD(TestCodec::testSizeMismatch);
+    if constexpr (std::is_same_v<S, SimpleStreamSerializer>) {
+      TEST_ADD(TestCodec::testFixedBuffer);
+    }
+  }
+
+  void testGenericCompatibility() {
+    auto book = createBook();
+    BufferOutputStream generic{};
+    {
+      S s{generic};
+      serialize::serialize(s, book);
+      s.flush();
+    }
+    BufferOutputStream compiled{};
+    {
+      S s{compiled};
+      CompiledCodec<S, CodecBook>::encode(s, book);
+      s.flush();
+    }
+    testAssert(std::ranges::equal(generic.data(), compiled.data()));
+
+    SpanInputStream in{generic.data()};
+    D d{in};
+    testAssertEquals(book, (CompiledCodec<S, CodecBook>::decode(d)));
+  }
+
+  void testRoundTrip() {
+    auto book = createBook();
+    CodecBook empty{};
+    BufferOutputStream out{};
+    {
+      S s{out};
+      CompiledCodec<S, CodecBook>::encode(s, book);
+      CompiledCodec<S, CodecBook>::encode(s, empty);
+      s.flush();
+    }
+
+    SpanInputStream in{out.data()};
+    D d{in};
+    CodecBook result{};
+    CompiledCodec<S, CodecBook>::decodeInto(d, result);
+    testAssertEquals(book, result);
+    testAssertEquals(empty, deserialize<CodecBook>(d));
+  }
+
+  void testFundamental() {
+    BufferOutputStream out{};
+    {
+      S s{out};
+      CompiledCodec<S, int64_t>::encode(s, -17);
+      s.flush();
+    }
+    SpanInputStream in{out.data()};
+    D d{in};
+    testAssertEquals(-17, (CompiledCodec<S, int64_t>::decode(d)));
+  }
+
+  void testSizeMismatch() {
+    BufferOutputStream out{};
+    {
+      S s{out};
+      serialize::serialize(s, std::vector<std::string>{"foo", "bar", "baz"});
+      s.flush();
+    }
+    SpanInputStream in{out.data()};
+    D d{in};
+    testThrows<std::domain_error>([&] { CompiledCodec<S, std::array<std::string, 2>>::decode(d); });
+  }
+
+  void testFixedBuffer() {
+    CodecHeader header{42, 17, {'a', 'b', 'c', 'd'}};
+    FixedBufferSerializer<64> generic{};
+    serialize::serialize(generic, header);
+    FixedBufferSerializer<64> compiled{};
+    CompiledCodec<FixedBufferSerializer<64>, CodecHeader>::encode(compiled, header);
+    testAssertEquals(generic.size(), compiled.size());
+    testAssert(generic.data() == compiled.data());
+
+    FixedBufferDeserializer d{compiled.data()};
+    testAssertEquals(header, (CompiledCodec<FixedBufferSerializer<64>, CodecHeader>::decode(d)));
+    FixedBufferDeserializer eof{std::span{compiled.data()}.first(compiled.size() - 1)};
+    testThrows<std::out_of_range>([&] { CompiledCodec<FixedBufferSerializer<64>, CodecHeader>::decode(eof); });
+  }
+};
+
+void registerCodecTests() { registerBackendSuites<TestCodec>("codec", "Codec"); }
@@ -0,0 +1,176 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "columnar.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <deque>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct Tick {
+  uint64_t timestamp;
+  double price;
+  uint32_t volume;
+  int16_t change;
+  float weight;
+  bool buy;
+  std::string venue;
+
+  auto operator<=>(const Tick& other) const noexcept = default;
+};
+
+template <typename S, typename D> class TestColumnar : public Test::Suite {
+public:
+  explicit TestColumnar(const std::string& name) : Suite(name) {
+    TEST_ADD(TestColumnar::testRoundTrip);
+    TEST_ADD(TestColumnar::testEmptyContainer);
+    TEST_ADD(TestColumnar::testOtherContainers);
+    TEST_ADD(TestColumnar::testExtremeValues);
+    TEST_ADD(TestColumnar::testSkipColumns);
+    TEST_ADD(TestColumnar::testInvalidEncoding);
+    if constexpr (!std::is_same_v<S, SimpleStreamSerializer>) {
+      // the Simple serializer writes all values with their fixed size in both layouts
+      TEST_ADD(TestColumnar::testReducesSize);
+    }
+  }
+
+  void testRoundTrip() {
+    auto ticks = createTicks(5000);
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeColumnar(s, ticks);
+      s.flush();
+    }
+
+    D d{ss};
+    testAssertEquals(ticks, deserializeColumnar<std::vector<Tick>>(d));
+  }
+
+  void testEmptyContainer() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeColumnar(s, std::vector<Tick>{});
+      serialize::serialize(s, 42U);
+      s.flush();
+    }
+
+    D d{ss};
+    testAssertEquals(0U, deserializeColumnar<std::vector<Tick>>(d).size());
+    testAssertEquals(42U, deserialize<unsigned>(d));
+  }
+
+  void testOtherContainers() {
+    auto ticks = createTicks(100);
+    std::list<Tick> list{ticks.begin(), ticks.end()};
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeColumnar(s, list);
+      s.flush();
+    }
+
+    D d{ss};
+    auto result = deserializeColumnar<std::deque<Tick>>(d);
+    testAssertEquals(ticks.size(), result.size());
+    testAssert(std::equal(ticks.begin(), ticks.end(), result.begin()));
+  }
+
+  void testExtremeValues() {
+    std::vector<Tick> ticks{
+        {0, -0.0, 0, std::numeric_limits<int16_t>::min(), std::numeric_limits<float>::infinity(), false, ""},
+        {std::numeric_limits<uint64_t>::max(), std::numeric_limits<double>::max(),
+         std::numeric_limits<uint32_t>::max(), std::numeric_limits<int16_t>::max(),
+         std::numeric_limits<float>::denorm_min(), true, "x"},
+        {1, std::numeric_limits<double>::lowest(), 0, -1, -std::numeric_limits<float>::infinity(), true, "y"},
+    };
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeColumnar(s, ticks);
+      s.flush();
+    }
+
+    D d{ss};
+    testAssertEquals(ticks, deserializeColumnar<std::vector<Tick>>(d));
+  }
+
+  void testSkipColumns() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeColumnar(s, createTicks(300));
+      serialize::serialize(s, std::string{"Tail"});
+      s.flush();
+    }
+
+    D d{ss};
+    skipColumnar<std::vector<Tick>>(d);
+    testAssertEquals(std::string{"Tail"}, deserialize<std::string>(d));
+  }
+
+  void testInvalidEncoding() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serialize::serialize(s, std::size_t{1});
+      // XOR encoding for the integral timestamp column
+      serialize::serialize(s, static_cast<uint8_t>(ColumnEncoding::XOR));
+      s.flush();
+    }
+
+    D d{ss};
+    testThrows<std::domain_error>([&] { deserializeColumnar<std::vector<Tick>>(d); });
+  }
+
+  void testReducesSize() {
+    auto ticks = createTicks(5000);
+    std::stringstream rows{};
+    {
+      S s{rows};
+      serialize::serialize(s, ticks);
+      s.flush();
+    }
+    std::stringstream columns{};
+    {
+      S s{columns};
+      serializeColumnar(s, ticks);
+      s.flush();
+    }
+    testAssert(columns.str().size() < rows.str().size() * 2 / 3);
+  }
+
+private:
+  static std::vector<Tick> createTicks(std::size_t numTicks) {
+    static const std::vector<std::string> venues{"XNAS", "XNYS", "XLON"};
+    std::vector<Tick> ticks{};
+    uint64_t timestamp = 1700000000000000;
+    double price = 187.25;
+    for (std::size_t i = 0; i < numTicks; ++i) {
+      timestamp += 1000 + (i * 7919) % 300;
+      auto change = static_cast<int16_t>(static_cast<int>((i * 31) % 9) - 4);
+      price += change * 0.25;
+      ticks.push_back(Tick{timestamp, price, static_cast<uint32_t>(100 * ((i * 13) % 50)), change,
+                           static_cast<float>(i % 4) * 0.5F, i % 3 == 0, venues[i % venues.size()]});
+    }
+    return ticks;
+  }
+};
+
+void registerColumnarTests() { registerBackendSuites<TestColumnar>("columnar", "Columnar"); }
@@ -0,0 +1,343 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "compression.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct LogMessage {
+  uint64_t timestamp;
+  std::string level;
+  std::string text;
+  std::vector<int32_t> values;
+
+  auto operator<=>(const LogMessage& other) const noexcept = default;
+};
+
+template <typename S, typename D> class TestCompression : public Test::Suite {
+public:
+  explicit TestCompression(const std::string& name) : Suite(name) {
+    TEST_ADD(TestCompression::testCodecRoundTrip);
+    TEST_ADD(TestCompression::testCodecOverlappingMatches);
+    TEST_ADD(TestCompression::testCodecMalformedData);
+    TEST_ADD(TestCompression::testRepetitiveData);
+    TEST_ADD(TestCompression::testIncompressibleData);
+    TEST_ADD(TestCompression::testSmallBlocks);
+    TEST_ADD(TestCompression::testMultipleFlushes);
+    TEST_ADD(TestCompression::testSkipValues);
+    TEST_ADD(TestCompression::testCorruptedData);
+    TEST_ADD(TestCompression::testCorruptedBlockSize);
+    TEST_ADD(TestCompression::testLargeBlocks);
+    TEST_ADD(TestCompression::testTruncatedData);
+    TEST_ADD(TestCompression::testParallelCompression);
+    TEST_ADD(TestCompression::testParallelDecompression);
+    TEST_ADD(TestCompression::testParallelCorruptedData);
+  }
+
+  void testCodecRoundTrip() {
+    for (std::size_t size : {0U, 1U, 3U, 4U, 15U, 16U, 300U, 70000U}) {
+      std::vector<std::byte> input(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        input[i] = static_cast<std::byte>((i % 97) ^ (i / 300));
+      }
+      std::vector<std::byte> compressed{};
+      detail::compressBlock(input, compressed);
+      std::vector<std::byte> output(size);
+      detail::decompressBlock(compressed, output);
+      testAssertEquals(input, output);
+    }
+  }
+
+  void testCodecOverlappingMatches() {
+    // long runs of the same byte are encoded as matches overlapping with their own output
+    std::vector<std::byte> input(5000, std::byte{'x'});
+    input.push_back(std::byte{'y'});
+    std::vector<std::byte> compressed{};
+    detail::compressBlock(input, compressed);
+    testAssert(compressed.size() < 64U);
+    std::vector<std::byte> output(input.size());
+    detail::decompressBlock(compressed, output);
+    testAssertEquals(input, output);
+  }
+
+  void testCodecMalformedData() {
+    std::vector<std::byte> output(16);
+    // empty input
+    testThrows<std::domain_error>([&] { detail::decompressBlock({}, output); });
+    // too many literals
+    std::vector<std::byte> literals{std::byte{0xF0}, std::byte{0x10}};
+    testThrows<std::domain_error>([&] { detail::decompressBlock(literals, output); });
+    // match before the start of the output
+    std::vector<std::byte> match{std::byte{0x10}, std::byte{'a'}, std::byte{0x02}, std::byte{0x00}, std::byte{0x00}};
+    testThrows<std::domain_error>([&] { detail::decompressBlock(match, output); });
+    // output not completely filled
+    std::vector<std::byte> shortInput{std::byte{0x10}, std::byte{'a'}};
+    testThrows<std::domain_error>([&] { detail::decompressBlock(shortInput, output); });
+  }
+
+  void testRepetitiveData() {
+    auto messages = createMessages(2000);
+    std::stringstream uncompressed{};
+    {
+      S s{uncompressed};
+      serialize::serialize(s, messages);
+      s.flush();
+    }
+    std::stringstream compressed{};
+    {
+      CompressedSerializer<S> s{compressed};
+      serialize::serialize(s, messages);
+      s.flush();
+    }
+    testAssert(compressed.str().size() * 3 < uncompressed.str().size());
+
+    CompressedDeserializer<D> d{compressed};
+    testAssertEquals(messages, deserialize<std::vector<LogMessage>>(d));
+  }
+
+  void testIncompressibleData() {
+    std::mt19937_64 generator{42};
+    std::vector<uint64_t> values(20000);
+    for (auto& value : values) {
+      value = generator();
+    }
+    std::stringstream uncompressed{};
+    {
+      S s{uncompressed};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+    std::stringstream compressed{};
+    {
+      CompressedSerializer<S> s{compressed};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+    // stored uncompressed, only the block headers are added
+    testAssert(compressed.str().size() <= uncompressed.str().size() + 64U);
+
+    CompressedDeserializer<D> d{compressed};
+    testAssertEquals(values, deserialize<std::vector<uint64_t>>(d));
+  }
+
+  void testSmallBlocks() {
+    auto messages = createMessages(100);
+    std::stringstream ss{};
+    {
+      CompressedSerializer<S> s{ss, 7};
+      serialize::serialize(s, messages);
+      s.flush();
+    }
+
+    CompressedDeserializer<D> d{ss};
+    testAssertEquals(messages, deserialize<std::vector<LogMessage>>(d));
+  }
+
+  void testMultipleFlushes() {
+    auto messages = createMessages(10);
+    std::stringstream ss{};
+    CompressedSerializer<S> s{ss};
+    serialize::serialize(s, messages);
+    s.flush();
+    // everything written is available after flushing
+    CompressedDeserializer<D> d{ss};
+    testAssertEquals(messages, deserialize<std::vector<LogMessage>>(d));
+
+    // flushing without new data does not write anything
+    auto size = ss.str().size();
+    s.flush();
+    testAssertEquals(size, ss.str().size());
+  }
+
+  void testSkipValues() {
+    std::stringstream ss{};
+    {
+      CompressedSerializer<S> s{ss};
+      serialize::serialize(s, createMessages(50));
+      serialize::serialize(s, std::string{"Tail"});
+      s.flush();
+    }
+
+    CompressedDeserializer<D> d{ss};
+    skip<std::vector<LogMessage>>(d);
+    testAssertEquals(std::string{"Tail"}, deserialize<std::string>(d));
+  }
+
+  void testCorruptedData() {
+    {
+      // stored size bigger than the uncompressed block size
+      std::stringstream ss{};
+      BytePackingSinkSerializer header{ss};
+      header.write(10U);
+      header.write(20U);
+      ss << std::string(20, 'a');
+
+      CompressedDeserializer<D> d{ss};
+      testThrows<std::domain_error>([&] { deserialize<uint32_t>(d); });
+    }
+    {
+      // match before the start of the block
+      std::stringstream ss{};
+      BytePackingSinkSerializer header{ss};
+      header.write(16U);
+      header.write(5U);
+      ss << std::string{"\x10" "a\x02\x00\x00", 5};
+
+      CompressedDeserializer<D> d{ss};
+      testThrows<std::domain_error>([&] { deserialize<uint32_t>(d); });
+    }
+  }
+
+  void testCorruptedBlockSize() {
+    // huge block size with a single stored byte, must not try to allocate the block
+    std::string data{};
+    {
+      std::stringstream ss{};
+      BytePackingSinkSerializer header{ss};
+      header.write(uint64_t{1} << 56U);
+      header.write(1U);
+      ss << 'a';
+      data = ss.str();
+    }
+    {
+      std::stringstream ss{data};
+      CompressedDeserializer<D> d{ss};
+      testThrows<std::domain_error>([&] { deserialize<uint32_t>(d); });
+    }
+    ThreadPool pool{2};
+    std::stringstream ss{data};
+    CompressedDeserializer<D> d{ss, pool};
+    testThrows<std::domain_error>([&] { deserialize<uint32_t>(d); });
+  }
+
+  void testLargeBlocks() {
+    constexpr std::size_t BLOCK_SIZE = 4 * CompressingOutputStream::DEFAULT_BLOCK_SIZE;
+    auto messages = createMessages(10000);
+    std::stringstream ss{};
+    {
+      CompressedSerializer<S> s{ss, BLOCK_SIZE};
+      serialize::serialize(s, messages);
+      s.flush();
+    }
+    {
+      std::stringstream copy{ss.str()};
+      CompressedDeserializer<D> d{copy};
+      testThrows<std::domain_error>([&] { deserialize<std::vector<LogMessage>>(d); });
+    }
+    CompressedDeserializer<D> d{ss, BLOCK_SIZE};
+    testAssertEquals(messages, deserialize<std::vector<LogMessage>>(d));
+  }
+
+  void testTruncatedData() {
+    std::stringstream ss{};
+    {
+      CompressedSerializer<S> s{ss};
+      serialize::serialize(s, createMessages(100));
+      s.flush();
+    }
+    auto data = ss.str();
+    std::stringstream truncated{data.substr(0, data.size() - 10)};
+
+    CompressedDeserializer<D> d{truncated};
+    testThrows<std::out_of_range>([&] { deserialize<std::vector<LogMessage>>(d); });
+  }
+
+  void testParallelCompression() {
+    auto messages = createMessages(5000);
+    std::stringstream sequential{};
+    {
+      CompressedSerializer<S> s{sequential, 1024};
+      serialize::serialize(s, messages);
+      s.flush();
+    }
+    ThreadPool pool{4};
+    std::stringstream parallel{};
+    {
+      CompressedSerializer<S> s{parallel, pool, 1024};
+      serialize::serialize(s, messages);
+      s.flush();
+      serialize::serialize(s, std::string{"Tail"});
+      // not flushed, written on destruction
+    }
+    // the blocks are compressed independently, so the output is identical
+    testAssertEquals(sequential.str(), parallel.str().substr(0, sequential.str().size()));
+
+    CompressedDeserializer<D> d{parallel};
+    testAssertEquals(messages, deserialize<std::vector<LogMessage>>(d));
+  }
+
+  void testParallelDecompression() {
+    auto messages = createMessages(5000);
+    std::stringstream ss{};
+    {
+      CompressedSerializer<S> s{ss, 512};
+      serialize::serialize(s, messages);
+      serialize::serialize(s, std::string{"Tail"});
+      s.flush();
+    }
+
+    ThreadPool pool{4};
+    {
+      std::stringstream copy{ss.str()};
+      CompressedDeserializer<D> d{copy, pool};
+      testAssertEquals(messages, deserialize<std::vector<LogMessage>>(d));
+      testAssertEquals(std::string{"Tail"}, deserialize<std::string>(d));
+    }
+    {
+      // stop reading in the middle with blocks still in flight
+      std::stringstream copy{ss.str()};
+      CompressedDeserializer<D> d{copy, pool};
+      testAssertEquals(messages.size(), deserialize<std::size_t>(d));
+      testAssertEquals(messages.front(), deserialize<LogMessage>(d));
+    }
+  }
+
+  void testParallelCorruptedData() {
+    std::stringstream ss{};
+    {
+      CompressedSerializer<S> s{ss, 512};
+      serialize::serialize(s, createMessages(100));
+      s.flush();
+    }
+    // append a block with a match before the start of the block
+    BytePackingSinkSerializer header{ss};
+    header.write(16U);
+    header.write(5U);
+    ss << std::string{"\x10" "a\x02\x00\x00", 5};
+
+    ThreadPool pool{2};
+    CompressedDeserializer<D> d{ss, pool};
+    testAssertEquals(createMessages(100), deserialize<std::vector<LogMessage>>(d));
+    testThrows<std::domain_error>([&] { deserialize<uint32_t>(d); });
+  }
+
+private:
+  static std::vector<LogMessage> createMessages(std::size_t numMessages) {
+    static const std::string LEVELS[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+    std::vector<LogMessage> messages{};
+    for (std::size_t i = 0; i < numMessages; ++i) {
+      messages.push_back(LogMessage{1700000000000 + i * 13, LEVELS[i % 4],
+                                    "Order " + std::to_string(i % 17) + " updated by client session",
+                                    std::vector<int32_t>(i % 5, static_cast<int32_t>(i % 3))});
+    }
+    return messages;
+  }
+};
+
+void registerCompressionTests() { registerBackendSuites<TestCompression>("compression", "Compression"); }
@@ -0,0 +1,222 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "delta.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct Entity {
+  uint32_t id;
+  double x;
+  double y;
+  std::string tag;
+
+  auto operator<=>(const Entity& other) const noexcept = default;
+};
+
+struct Settings {
+  uint16_t rate;
+  bool enabled;
+  std::array<float, 4> weights;
+
+  auto operator<=>(const Settings& other) const noexcept = default;
+};
+
+struct WorldState {
+  uint64_t sequence;
+  std::string name;
+  std::vector<Entity> entities;
+  Settings settings;
+  std::map<int, std::string> labels;
+  std::vector<bool> flags;
+
+  auto operator<=>(const WorldState& other) const noexcept = default;
+};
+
+template <typename S, typename D> class TestDelta : public Test::Suite {
+public:
+  explicit TestDelta(const std::string& name) : Suite(name) {
+    TEST_ADD(TestDelta::testUnchanged);
+    TEST_ADD(TestDelta::testChangedMembers);
+    TEST_ADD(TestDelta::testSparseChanges);
+    TEST_ADD(TestDelta::testDenseChanges);
+    TEST_ADD(TestDelta::testResizedContainers);
+    TEST_ADD(TestDelta::testSuccessiveDeltas);
+    TEST_ADD(TestDelta::testFundamentalValues);
+    TEST_ADD(TestDelta::testInvalidDelta);
+  }
+
+  void testUnchanged() {
+    auto state = createState(1000);
+    std::stringstream ss{};
+    {
+      S s{ss};
+      testAssert(!serializeDelta(s, state, state));
+      s.flush();
+    }
+
+    D d{ss};
+    auto copy = state;
+    testAssert(!applyDelta(d, copy));
+    testAssertEquals(state, copy);
+  }
+
+  void testChangedMembers() {
+    auto previous = createState(1000);
+    auto current = previous;
+    current.sequence++;
+    current.settings.weights[2] = 0.75F;
+    current.labels[99] = "ninety-nine";
+    current.flags[3] = !current.flags[3];
+    checkDelta(previous, current);
+  }
+
+  void testSparseChanges() {
+    auto previous = createState(1000);
+    auto current = previous;
+    current.entities[17].x += 1.0;
+    current.entities[500].tag = "moved";
+    current.entities[999].y = -3.5;
+    auto deltaSize = checkDelta(previous, current);
+
+    std::stringstream full{};
+    {
+      S s{full};
+      serialize::serialize(s, current.entities);
+      s.flush();
+    }
+    // only a small fraction of the full state is written
+    testAssert(deltaSize * 20 < full.str().size());
+  }
+
+  void testDenseChanges() {
+    auto previous = createState(200);
+    auto current = previous;
+    for (std::size_t i = 0; i < current.entities.size(); i += 3) {
+      current.entities[i].id += 1000;
+    }
+    checkDelta(previous, current);
+  }
+
+  void testResizedContainers() {
+    auto previous = createState(100);
+    auto current = previous;
+    current.entities.resize(60);
+    current.entities[10].tag = "shrunk";
+    checkDelta(previous, current);
+
+    previous = current;
+    current.entities.push_back(Entity{12345, 1.0, 2.0, "appended"});
+    current.entities.push_back(Entity{12346, 3.0, 4.0, "appended"});
+    current.entities[0].x = 42.0;
+    current.flags.push_back(true);
+    checkDelta(previous, current);
+
+    previous = current;
+    current.entities.clear();
+    checkDelta(previous, current);
+  }
+
+  void testSuccessiveDeltas() {
+    auto state = createState(300);
+    auto replica = state;
+    for (uint32_t round = 0; round < 20; ++round) {
+      auto next = state;
+      next.sequence = round;
+      next.entities[(round * 37) % next.entities.size()].x += round;
+      if (round % 5 == 0) {
+        next.entities.push_back(Entity{round, 0.0, 0.0, "spawned"});
+      }
+      // every delta is sent as a separate message
+      std::stringstream ss{};
+      S s{ss};
+      serializeDelta(s, state, next);
+      s.flush();
+      state = next;
+
+      D d{ss};
+      applyDelta(d, replica);
+      testAssertEquals(state, replica);
+    }
+  }
+
+  void testFundamentalValues() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeDelta(s, 17, 42);
+      serializeDelta(s, std::string{"foo"}, std::string{"foo"});
+      serializeDelta(s, std::vector<int>{1, 2, 3}, std::vector<int>{1, 5, 3, 7});
+      s.flush();
+    }
+
+    D d{ss};
+    int value = 17;
+    testAssert(applyDelta(d, value));
+    testAssertEquals(42, value);
+    std::string text{"foo"};
+    testAssert(!applyDelta(d, text));
+    std::vector<int> values{1, 2, 3};
+    testAssert(applyDelta(d, values));
+    testAssertEquals((std::vector<int>{1, 5, 3, 7}), values);
+  }
+
+  void testInvalidDelta() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serializeDelta(s, std::vector<int>{1, 2, 3, 4}, std::vector<int>{1, 2, 3, 5});
+      s.flush();
+    }
+
+    // applied to a different previous version than it was created for
+    D d{ss};
+    std::vector<int> values{1, 2};
+    testThrows<std::domain_error>([&] { applyDelta(d, values); });
+  }
+
+private:
+  std::size_t checkDelta(const WorldState& previous, const WorldState& current) {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      testAssert(serializeDelta(s, previous, current));
+      s.flush();
+    }
+
+    D d{ss};
+    auto replica = previous;
+    testAssert(applyDelta(d, replica));
+    testAssertEquals(current, replica);
+    return ss.str().size();
+  }
+
+  static WorldState createState(std::size_t numEntities) {
+    WorldState state{1, "world", {}, Settings{60, true, {0.25F, 0.5F, 1.0F, 2.0F}}, {{1, "one"}, {2, "two"}}, {}};
+    for (std::size_t i = 0; i < numEntities; ++i) {
+      state.entities.push_back(Entity{static_cast<uint32_t>(i), static_cast<double>(i) * 1.5,
+                                      static_cast<double>(i) * -0.5, "entity" + std::to_string(i)});
+      state.flags.push_back(i % 7 == 0);
+    }
+    return state;
+  }
+};
+
+void registerDeltaTests() { registerBackendSuites<TestDelta>("delta", "Delta"); }
@@ -0,0 +1,123 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "fixed_buffer.hpp"
+
+#include "simple.hpp"
+#include "skip.hpp"
+#include "streams.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace serialize;
+
+struct LookupEntry {
+  uint16_t key;
+  float factor;
+  std::array<int8_t, 3> offsets;
+  bool enabled;
+
+  constexpr auto operator<=>(const LookupEntry& other) const noexcept = default;
+};
+
+struct Configuration {
+  uint32_t version;
+  double timeout;
+  std::pair<char, uint64_t> limits;
+  std::array<LookupEntry, 4> table;
+
+  constexpr auto operator<=>(const Configuration& other) const noexcept = default;
+};
+
+static constexpr Configuration createConfiguration() {
+  Configuration config{7, 2.5, {'x', 1ULL << 40}, {}};
+  for (uint16_t i = 0; i < config.table.size(); ++i) {
+    config.table[i] = LookupEntry{static_cast<uint16_t>(i * 100), static_cast<float>(i) * 0.25F,
+                                  {static_cast<int8_t>(-i), 0, static_cast<int8_t>(i)}, i % 2 == 0};
+  }
+  return config;
+}
+
+// encoded at compile time
+static constexpr auto CONFIGURATION_SIZE = serializedSize(createConfiguration());
+static constexpr auto CONFIGURATION_BLOB = serializeToArray<CONFIGURATION_SIZE>(createConfiguration());
+
+static_assert(deserializeFromBuffer<Configuration>(CONFIGURATION_BLOB) == createConfiguration());
+
+// dynamically allocating types can be used within the constant evaluation
+static_assert([] {
+  std::vector<std::string> names{"foo", "a much longer string not fitting into the small string buffer", ""};
+  FixedBufferSerializer<256> serializer{};
+  serialize::serialize(serializer, names);
+  FixedBufferDeserializer deserializer{serializer.data()};
+  auto result = deserialize<std::vector<std::string>>(deserializer);
+  return result == names && deserializer.remaining() == serializer.data().size() - serializer.size();
+}());
+
+class TestFixedBuffer : public Test::Suite {
+public:
+  TestFixedBuffer() : Suite("FixedBuffer") {
+    TEST_ADD(TestFixedBuffer::testCompileTimeBlob);
+    TEST_ADD(TestFixedBuffer::testSimpleCompatibility);
+    TEST_ADD(TestFixedBuffer::testSkip);
+    TEST_ADD(TestFixedBuffer::testBufferOverflow);
+    TEST_ADD(TestFixedBuffer::testEof);
+  }
+
+  void testCompileTimeBlob() {
+    testAssertEquals(CONFIGURATION_SIZE, CONFIGURATION_BLOB.size());
+    testAssertEquals(createConfiguration(), deserializeFromBuffer<Configuration>(CONFIGURATION_BLOB));
+  }
+
+  void testSimpleCompatibility() {
+    SpanInputStream in{std::span<const std::byte>{CONFIGURATION_BLOB}};
+    SimpleStreamDeserializer d{in};
+    testAssertEquals(createConfiguration(), deserialize<Configuration>(d));
+
+    std::pair<std::string, std::vector<int32_t>> value{"foo", {1, -2, 3}};
+    BufferOutputStream out{};
+    SimpleStreamSerializer s{out};
+    serialize::serialize(s, value);
+    s.flush();
+    FixedBufferSerializer<64> fixed{};
+    serialize::serialize(fixed, value);
+    testAssertEquals(out.data().size(), fixed.size());
+    testAssert(std::ranges::equal(out.data(), std::span{fixed.data()}.first(fixed.size())));
+  }
+
+  void testSkip() {
+    FixedBufferSerializer<64> s{};
+    serialize::serialize(s, std::string{"skipped"});
+    serialize::serialize(s, int16_t{-17});
+    FixedBufferDeserializer d{s.data()};
+    serialize::skip<std::string>(d);
+    testAssertEquals(-17, deserialize<int16_t>(d));
+  }
+
+  void testBufferOverflow() {
+    FixedBufferSerializer<10> s{};
+    serialize::serialize(s, uint64_t{42});
+    testThrows<std::out_of_range>([&] { serialize::serialize(s, uint32_t{17}); });
+    testAssertEquals(8U, s.size());
+  }
+
+  void testEof() {
+    std::array<std::byte, 3> data{};
+    FixedBufferDeserializer d{data};
+    testThrows<std::out_of_range>([&] { deserialize<uint32_t>(d); });
+    testThrows<std::out_of_range>([&] { d.skip<uint16_t>(2); });
+    testAssertEquals(3U, d.remaining());
+  }
+};
+
+void registerFixedBufferTests() { Test::registerSuite(Test::newInstance<TestFixedBuffer>, "fixed-buffer"); }
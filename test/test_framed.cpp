@@ -0,0 +1,176 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "framed.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct FramedRecord {
+  uint32_t id;
+  std::string name;
+  std::vector<int64_t> values;
+  bool flag;
+
+  auto operator<=>(const FramedRecord& other) const noexcept = default;
+};
+
+template <typename S, typename D> class TestFramedStream : public Test::Suite {
+public:
+  explicit TestFramedStream(const std::string& name) : Suite(name) {
+    TEST_ADD(TestFramedStream::testIterateRecords);
+    TEST_ADD(TestFramedStream::testEmptyStream);
+    TEST_ADD(TestFramedStream::testSkipRecords);
+    TEST_ADD(TestFramedStream::testRangeAdaptors);
+    TEST_ADD(TestFramedStream::testThrowOnEof);
+    TEST_ADD(TestFramedStream::testMaxFrameSize);
+    TEST_ADD(TestFramedStream::testKeepErrorState);
+  }
+
+  void testIterateRecords() {
+    auto records = createRecords(17);
+    std::stringstream ss{};
+    writeRecords(ss, records);
+
+    FramedStreamReader<FramedRecord, D> reader{ss};
+    std::size_t index = 0;
+    for (const auto& record : reader) {
+      testAssertEquals(records.at(index), record);
+      ++index;
+    }
+    testAssertEquals(records.size(), index);
+    testAssert(reader.begin() == reader.end());
+  }
+
+  void testEmptyStream() {
+    std::stringstream ss{};
+    FramedStreamReader<FramedRecord, D> reader{ss};
+    testAssert(reader.begin() == reader.end());
+    testAssertEquals(0U, reader.skip(3));
+  }
+
+  void testSkipRecords() {
+    auto records = createRecords(10);
+    std::stringstream ss{};
+    writeRecords(ss, records);
+
+    FramedStreamReader<FramedRecord, D> reader{ss};
+    // skip before starting the iteration
+    testAssertEquals(2U, reader.skip(2));
+    auto it = reader.begin();
+    testAssertEquals(records[2], *it);
+    // skip the current record and the next one
+    testAssertEquals(2U, reader.skip(2));
+    testAssertEquals(records[4], *reader.begin());
+    ++it;
+    testAssertEquals(records[5].name, it->name);
+    // skip past the end
+    testAssertEquals(5U, reader.skip(17));
+    testAssert(reader.begin() == reader.end());
+    testAssertEquals(0U, reader.skip());
+  }
+
+  void testRangeAdaptors() {
+    auto records = createRecords(20);
+    std::stringstream ss{};
+    writeRecords(ss, records);
+
+    FramedStreamReader<FramedRecord, D> reader{ss};
+    std::vector<uint32_t> ids{};
+    for (auto id : reader | std::views::filter([](const FramedRecord& record) { return record.flag; }) |
+                       std::views::transform(&FramedRecord::id) | std::views::take(4)) {
+      ids.push_back(id);
+    }
+    testAssertEquals((std::vector<uint32_t>{0, 3, 6, 9}), ids);
+  }
+
+  void testThrowOnEof() {
+    auto records = createRecords(3);
+    std::stringstream ss{};
+    writeRecords(ss, records);
+    auto data = ss.str();
+    std::stringstream truncated{data.substr(0, data.size() - 2)};
+
+    FramedStreamReader<FramedRecord, D> reader{truncated};
+    auto it = reader.begin();
+    testAssertEquals(records[0], *it);
+    ++it;
+    testAssertEquals(records[1], *it);
+    testThrows<std::out_of_range>([&] { ++it; });
+  }
+
+  void testMaxFrameSize() {
+    {
+      // huge frame size with a single payload byte, must not try to allocate the frame
+      std::stringstream ss{};
+      BytePackingSinkSerializer header{ss};
+      header.write(uint64_t{1} << 56U);
+      header.flush();
+      ss << 'a';
+
+      FramedStreamReader<FramedRecord, D> reader{ss};
+      testThrows<std::domain_error>([&] { reader.begin(); });
+    }
+    auto records = createRecords(10);
+    std::stringstream ss{};
+    writeRecords(ss, records);
+    {
+      std::stringstream copy{ss.str()};
+      FramedStreamReader<FramedRecord, D> reader{copy, 8};
+      testThrows<std::domain_error>([&] { reader.begin(); });
+    }
+    FramedStreamReader<FramedRecord, D> reader{ss, 1024};
+    std::vector<FramedRecord> result{};
+    for (const auto& record : reader) {
+      result.push_back(record);
+    }
+    testAssertEquals(records, result);
+  }
+
+  void testKeepErrorState() {
+    auto records = createRecords(3);
+    std::stringstream ss{};
+    writeRecords(ss, records);
+    ss.setstate(std::ios_base::failbit);
+
+    FramedStreamReader<FramedRecord, D> reader{ss};
+    testAssert(reader.begin() == reader.end());
+    // only the EOF flag is cleared at the end of the stream
+    testAssert(ss.fail());
+  }
+
+private:
+  static std::vector<FramedRecord> createRecords(std::size_t numRecords) {
+    std::vector<FramedRecord> records{};
+    for (std::size_t i = 0; i < numRecords; ++i) {
+      records.push_back(FramedRecord{static_cast<uint32_t>(i), "Record " + std::to_string(i),
+                                     std::vector<int64_t>(i % 5, -static_cast<int64_t>(i * 1000)), i % 3 == 0});
+    }
+    return records;
+  }
+
+  static void writeRecords(std::ostream& out, const std::vector<FramedRecord>& records) {
+    FramedStreamWriter<S> writer{out};
+    for (const auto& record : records) {
+      writer.write(record);
+    }
+    writer.flush();
+  }
+};
+
+void registerFramedTests() { registerBackendSuites<TestFramedStream>("framed", "Framed"); }
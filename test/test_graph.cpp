@@ -0,0 +1,233 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "graph.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct Subtree {
+  std::string name;
+  std::vector<uint32_t> values;
+
+  auto operator<=>(const Subtree& other) const noexcept = default;
+};
+
+struct TreeNode {
+  std::string name;
+  std::vector<std::shared_ptr<TreeNode>> children;
+  std::weak_ptr<TreeNode> parent;
+};
+
+struct Labeled {
+  Labeled(std::string label, std::shared_ptr<Labeled> next) : label(std::move(label)), next(std::move(next)) {}
+
+  std::string label;
+  std::shared_ptr<Labeled> next;
+};
+
+// not default-constructible, so needs an explicit deserialization function
+template <>
+inline constexpr auto serialize::deserialize<Labeled> = [](Deserializer auto& deserializer) {
+  return Labeled{deserialize<std::string>(deserializer), deserialize<std::shared_ptr<Labeled>>(deserializer)};
+};
+
+template <typename S, typename D> class TestGraph : public Test::Suite {
+public:
+  explicit TestGraph(const std::string& name) : Suite(name) {
+    TEST_ADD(TestGraph::testSharedObjects);
+    TEST_ADD(TestGraph::testReducesSize);
+    TEST_ADD(TestGraph::testEmptyPointers);
+    TEST_ADD(TestGraph::testCyclicReferences);
+    TEST_ADD(TestGraph::testSkipObjects);
+    TEST_ADD(TestGraph::testInvalidReference);
+    TEST_ADD(TestGraph::testTypeMismatch);
+    TEST_ADD(TestGraph::testNonDefaultConstructible);
+  }
+
+  void testSharedObjects() {
+    auto shared = createSubtree();
+    auto other = std::make_shared<const Subtree>(Subtree{"other", {1, 2, 3}});
+    std::vector<std::shared_ptr<const Subtree>> values{shared, other, shared, shared, other};
+    std::stringstream ss{};
+    {
+      ObjectGraphSerializer<S> s{S{ss}};
+      serialize::serialize(s, values);
+      testAssertEquals(2U, s.numObjects());
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    auto result = deserialize<std::vector<std::shared_ptr<const Subtree>>>(d);
+    testAssertEquals(5U, result.size());
+    testAssertEquals(*shared, *result[0]);
+    testAssertEquals(*other, *result[1]);
+    testAssertEquals(result[0].get(), result[2].get());
+    testAssertEquals(result[0].get(), result[3].get());
+    testAssertEquals(result[1].get(), result[4].get());
+    testAssertEquals(2U, d.numObjects());
+  }
+
+  void testReducesSize() {
+    auto shared = createSubtree();
+    std::vector<std::shared_ptr<const Subtree>> values(100, shared);
+    std::stringstream ss{};
+    {
+      ObjectGraphSerializer<S> s{S{ss}};
+      serialize::serialize(s, values);
+      s.flush();
+    }
+    std::stringstream single{};
+    {
+      S s{single};
+      serialize::serialize(s, *shared);
+      s.flush();
+    }
+    // the subtree is only written once, followed by the references
+    testAssert(ss.str().size() < 2 * single.str().size());
+  }
+
+  void testEmptyPointers() {
+    std::stringstream ss{};
+    {
+      ObjectGraphSerializer<S> s{S{ss}};
+      serialize::serialize(s, std::shared_ptr<int>{});
+      serialize::serialize(s, std::weak_ptr<int>{});
+      serialize::serialize(s, std::make_shared<int>(42));
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    testAssert(!deserialize<std::shared_ptr<int>>(d));
+    testAssert(deserialize<std::weak_ptr<int>>(d).expired());
+    testAssertEquals(42, *deserialize<std::shared_ptr<int>>(d));
+  }
+
+  void testCyclicReferences() {
+    auto root = std::make_shared<TreeNode>();
+    root->name = "root";
+    for (std::size_t i = 0; i < 3; ++i) {
+      auto child = std::make_shared<TreeNode>();
+      child->name = "child" + std::to_string(i);
+      child->parent = root;
+      root->children.push_back(child);
+    }
+    // the same child can be linked from multiple parents
+    root->children[0]->children.push_back(root->children[2]);
+    std::stringstream ss{};
+    {
+      ObjectGraphSerializer<S> s{S{ss}};
+      serialize::serialize(s, root);
+      testAssertEquals(4U, s.numObjects());
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    auto result = deserialize<std::shared_ptr<TreeNode>>(d);
+    testAssertEquals(std::string{"root"}, result->name);
+    testAssert(result->parent.expired());
+    testAssertEquals(3U, result->children.size());
+    for (std::size_t i = 0; i < 3; ++i) {
+      testAssertEquals("child" + std::to_string(i), result->children[i]->name);
+      testAssertEquals(result.get(), result->children[i]->parent.lock().get());
+    }
+    testAssertEquals(1U, result->children[0]->children.size());
+    testAssertEquals(result->children[2].get(), result->children[0]->children[0].get());
+  }
+
+  void testSkipObjects() {
+    auto shared = createSubtree();
+    std::stringstream ss{};
+    {
+      ObjectGraphSerializer<S> s{S{ss}};
+      serialize::serialize(s, std::vector<std::shared_ptr<const Subtree>>{shared, shared});
+      serialize::serialize(s, shared);
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    // skipped objects still need to be registered to resolve later references
+    skip<std::vector<std::shared_ptr<const Subtree>>>(d);
+    testAssertEquals(*shared, *deserialize<std::shared_ptr<const Subtree>>(d));
+  }
+
+  void testInvalidReference() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serialize::serialize(s, detail::SHARED_REFERENCE_OFFSET + 3);
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    testThrows<std::domain_error>([&] { deserialize<std::shared_ptr<int>>(d); });
+  }
+
+  void testTypeMismatch() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serialize::serialize(s, detail::SHARED_NEW);
+      serialize::serialize(s, 17);
+      serialize::serialize(s, detail::SHARED_REFERENCE_OFFSET);
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    testAssertEquals(17, *deserialize<std::shared_ptr<int>>(d));
+    testThrows<std::domain_error>([&] { deserialize<std::shared_ptr<std::string>>(d); });
+  }
+
+  void testNonDefaultConstructible() {
+    std::stringstream ss{};
+    {
+      ObjectGraphSerializer<S> s{S{ss}};
+      serialize::serialize(s, std::make_shared<Labeled>("first", std::make_shared<Labeled>("second", nullptr)));
+      s.flush();
+    }
+    std::stringstream cyclic{};
+    {
+      // references itself before being constructed
+      S s{cyclic};
+      serialize::serialize(s, detail::SHARED_NEW);
+      serialize::serialize(s, std::string{"label"});
+      serialize::serialize(s, detail::SHARED_REFERENCE_OFFSET);
+      s.flush();
+    }
+
+    ObjectGraphDeserializer<D> d{D{ss}};
+    auto result = deserialize<std::shared_ptr<Labeled>>(d);
+    testAssertEquals(std::string{"first"}, result->label);
+    testAssertEquals(std::string{"second"}, result->next->label);
+    testAssert(!result->next->next);
+
+    ObjectGraphDeserializer<D> cyclicDeserializer{D{cyclic}};
+    testThrows<std::domain_error>([&] { deserialize<std::shared_ptr<Labeled>>(cyclicDeserializer); });
+  }
+
+private:
+  static std::shared_ptr<const Subtree> createSubtree() {
+    Subtree subtree{"large immutable subtree", {}};
+    for (uint32_t i = 0; i < 1000; ++i) {
+      subtree.values.push_back(i * 7919);
+    }
+    return std::make_shared<const Subtree>(std::move(subtree));
+  }
+};
+
+void registerGraphTests() { registerBackendSuites<TestGraph>("graph", "Graph"); }
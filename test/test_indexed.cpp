@@ -0,0 +1,134 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "indexed.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct IndexedElement {
+  int32_t id;
+  std::string name;
+
+  constexpr auto operator<=>(const IndexedElement& other) const noexcept = default;
+};
+
+struct IndexedRecord {
+  uint64_t timestamp;
+  FundamentalTypes fundamentals;
+  std::string comment;
+  std::vector<IndexedElement> elements;
+  std::array<int16_t, 4> shorts;
+  std::vector<double> values;
+  std::string tail;
+
+  auto operator<=>(const IndexedRecord& other) const noexcept = default;
+};
+
+class TestIndexedSerialization : public Test::Suite {
+public:
+  TestIndexedSerialization() : Suite("IndexedSerialization") {
+    TEST_ADD(TestIndexedSerialization::testRoundTrip);
+    TEST_ADD(TestIndexedSerialization::testLazyMemberAccess);
+    TEST_ADD(TestIndexedSerialization::testLazyElementAccess);
+    TEST_ADD(TestIndexedSerialization::testMultipleRecords);
+    TEST_ADD(TestIndexedSerialization::testThrowOnEof);
+  }
+
+  void testRoundTrip() {
+    auto data = serializeRecords({RECORD});
+    IndexedDeserializer deserializer{data};
+    testAssertEquals(RECORD, deserializer.next<IndexedRecord>().get());
+    testAssert(deserializer.empty());
+  }
+
+  void testLazyMemberAccess() {
+    auto data = serializeRecords({RECORD});
+    IndexedDeserializer deserializer{data};
+    auto view = deserializer.next<IndexedRecord>();
+    testAssertEquals(RECORD.tail, view.get<6>());
+    testAssertEquals(RECORD.timestamp, view.get<0>());
+    testAssertEquals(RECORD.comment, view.get<2>());
+    testAssertEquals(RECORD.fundamentals.ld, view.member<1>().get<10>());
+    testAssertEquals(RECORD.fundamentals, view.get<1>());
+  }
+
+  void testLazyElementAccess() {
+    auto data = serializeRecords({RECORD});
+    IndexedDeserializer deserializer{data};
+    auto view = deserializer.next<IndexedRecord>();
+    auto elements = view.member<3>();
+    testAssertEquals(RECORD.elements.size(), elements.size());
+    testAssertEquals(RECORD.elements.back().name, elements[RECORD.elements.size() - 1].get<1>());
+    testAssertEquals(RECORD.elements.front(), elements[0].get());
+    auto values = view.member<5>();
+    testAssertEquals(RECORD.values.size(), values.size());
+    testAssertEquals(RECORD.values[2], values[2].get());
+    testAssertEquals(RECORD.shorts, view.get<4>());
+    testAssertEquals(RECORD.shorts[3], view.member<4>()[3].get());
+    testAssertEquals(RECORD.tail.size(), view.member<6>().size());
+    testAssertEquals(RECORD.tail[3], view.member<6>()[3].get());
+    testThrows<std::out_of_range>([&] { std::ignore = values[RECORD.values.size()]; });
+  }
+
+  void testMultipleRecords() {
+    auto data = serializeRecords({RECORD, IndexedRecord{}, RECORD});
+    IndexedDeserializer deserializer{data};
+    testAssertEquals(RECORD.tail, deserializer.next<IndexedRecord>().get<6>());
+    testAssertEquals(IndexedRecord{}, deserializer.next<IndexedRecord>().get());
+    testAssertEquals(RECORD.elements, deserializer.next<IndexedRecord>().get<3>());
+    testAssert(deserializer.empty());
+  }
+
+  void testThrowOnEof() {
+    auto data = serializeRecords({RECORD});
+    // drop the tail of the record
+    IndexedDeserializer truncatedDeserializer{std::span{data}.first(data.size() - 4)};
+    testThrows<std::out_of_range>([&] { std::ignore = truncatedDeserializer.next<IndexedRecord>(); });
+
+    // corrupt the offset to the last member
+    auto corrupted = data;
+    corrupted[sizeof(uint64_t) + 6 * sizeof(uint32_t) + 3] = std::byte{0xFF};
+    IndexedDeserializer corruptedDeserializer{corrupted};
+    auto view = corruptedDeserializer.next<IndexedRecord>();
+    testAssertEquals(RECORD.timestamp, view.get<0>());
+    testThrows<std::out_of_range>([&] { std::ignore = view.get<6>(); });
+  }
+
+private:
+  static std::vector<std::byte> serializeRecords(const std::vector<IndexedRecord>& records) {
+    std::stringstream data{};
+    IndexedSerializer serializer{data};
+    for (const auto& record : records) {
+      serialize::serialize(serializer, record);
+    }
+    serializer.flush();
+    auto string = data.str();
+    auto bytes = std::as_bytes(std::span{string});
+    return std::vector<std::byte>{bytes.begin(), bytes.end()};
+  }
+
+  inline static const IndexedRecord RECORD{
+      1234567890123,
+      {-3, 17, -1234, 12345, -654321, 543213440, -3751985643563665, 43759353465875, -17.0f, 4365477356385674763.34563,
+       4357357985453435.43568463578623562, 'a', L'b', u8'A', u'c', U'd', true},
+      "Some comment",
+      {{1, "One"}, {2, "Two"}, {17, "Seventeen, which is long enough to not fit into the small string buffer"}},
+      {5, -6, 7, -8},
+      {1.0, -2.5, 1e100, 0.0},
+      "Foo bar baz",
+  };
+};
+
+void registerIndexedTests() { Test::registerSuite(Test::newInstance<TestIndexedSerialization>, "indexed"); }
@@ -0,0 +1,140 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "instrumented.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct InstrumentedMessage {
+  uint32_t id;
+  double value;
+  std::string name;
+  std::vector<int16_t> samples;
+
+  auto operator<=>(const InstrumentedMessage& other) const noexcept = default;
+};
+
+template <typename S, typename D> class TestInstrumented : public Test::Suite {
+public:
+  explicit TestInstrumented(const std::string& name) : Suite(name) {
+    TEST_ADD(TestInstrumented::testSerializerCounters);
+    TEST_ADD(TestInstrumented::testDeserializerCounters);
+    TEST_ADD(TestInstrumented::testObjectAttribution);
+    TEST_ADD(TestInstrumented::testMeasureTime);
+  }
+
+  void testSerializerCounters() {
+    std::stringstream plain{};
+    {
+      S s{plain};
+      writeValues(s);
+    }
+
+    std::stringstream ss{};
+    InstrumentedSerializer<S> s{ss};
+    writeValues(s);
+    // same output as the wrapped serializer
+    testAssertEquals(plain.str(), ss.str());
+
+    auto report = s.report();
+    testAssertEquals(ss.str().size(), report.totalBytes);
+    testAssertEquals(2U, report.template fundamental<uint32_t>().numValues);
+    testAssertEquals(1U, report.template fundamental<bool>().numValues);
+    testAssertEquals(0U, report.template fundamental<float>().numValues);
+    testAssertEquals(0U, report.template fundamental<float>().numBytes);
+    testAssertEquals(0, report.template fundamental<uint32_t>().duration.count());
+    std::size_t sumBytes = report.rawData.numBytes;
+    for (const auto& counters : report.fundamentals) {
+      sumBytes += counters.numBytes;
+    }
+    testAssert(sumBytes <= report.totalBytes);
+  }
+
+  void testDeserializerCounters() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      writeValues(s);
+    }
+    auto numBytes = ss.str().size();
+
+    InstrumentedDeserializer<D> d{ss};
+    testAssertEquals(17U, deserialize<uint32_t>(d));
+    testAssertEquals(std::string{"foo"}, deserialize<std::string>(d));
+    skip<uint32_t>(d);
+    testAssertEquals(true, deserialize<bool>(d));
+
+    auto report = d.report();
+    testAssertEquals(numBytes, report.totalBytes);
+    testAssertEquals(1U, report.template fundamental<uint32_t>().numValues);
+    testAssertEquals(3U, report.template fundamental<char>().numValues);
+    testAssertEquals(1U, report.template fundamental<bool>().numValues);
+  }
+
+  void testObjectAttribution() {
+    InstrumentedMessage message{42, 1.5, "message", {1, -2, 3}};
+    std::stringstream ss{};
+    {
+      InstrumentedSerializer<S> s{ss};
+      s.serializeObject(message);
+      s.serializeObject(message);
+      s.serializeObject(uint64_t{7});
+      s.flush();
+
+      auto report = s.report();
+      testAssertEquals(2U, report.template object<InstrumentedMessage>().numValues);
+      testAssertEquals(1U, report.template object<uint64_t>().numValues);
+      testAssertEquals(0U, report.template object<std::string>().numValues);
+      // pending bits are only written on flushing and are therefore not attributed to any object
+      testAssert(report.template object<InstrumentedMessage>().numBytes + report.template object<uint64_t>().numBytes <=
+                 report.totalBytes);
+      testAssert(report.template object<InstrumentedMessage>().numBytes > 0);
+      testAssertEquals(2U, report.template fundamental<uint32_t>().numValues);
+      std::stringstream table{};
+      table << report;
+      testAssert(table.str().find("InstrumentedMessage") != std::string::npos);
+    }
+
+    InstrumentedDeserializer<D> d{ss};
+    testAssertEquals(message, d.template deserializeObject<InstrumentedMessage>());
+    testAssertEquals(message, d.template deserializeObject<InstrumentedMessage>());
+    testAssertEquals(7U, d.template deserializeObject<uint64_t>());
+    testAssertEquals(2U, d.report().template object<InstrumentedMessage>().numValues);
+  }
+
+  void testMeasureTime() {
+    std::stringstream ss{};
+    InstrumentedSerializer<S, true> s{ss};
+    for (uint32_t i = 0; i < 1000; ++i) {
+      s.serializeObject(std::vector<uint32_t>(16, i));
+    }
+    s.flush();
+    auto report = s.report();
+    testAssert(report.template object<std::vector<uint32_t>>().duration.count() > 0);
+  }
+
+private:
+  template <typename Serializer> static void writeValues(Serializer& s) {
+    serialize::serialize(s, uint32_t{17});
+    serialize::serialize(s, std::string{"foo"});
+    serialize::serialize(s, uint32_t{42});
+    serialize::serialize(s, true);
+    s.flush();
+  }
+};
+
+void registerInstrumentedTests() { registerBackendSuites<TestInstrumented>("instrumented", "Instrumented"); }
@@ -0,0 +1,179 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "interning.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace serialize;
+
+struct Quote {
+  std::string symbol;
+  std::string exchange;
+  uint32_t price;
+
+  auto operator<=>(const Quote& other) const noexcept = default;
+};
+
+template <typename S, typename D> class TestInterning : public Test::Suite {
+public:
+  explicit TestInterning(const std::string& name) : Suite(name) {
+    TEST_ADD(TestInterning::testRoundTrip);
+    TEST_ADD(TestInterning::testReducesSize);
+    TEST_ADD(TestInterning::testStringViews);
+    TEST_ADD(TestInterning::testNestedStrings);
+    TEST_ADD(TestInterning::testSkipStrings);
+    TEST_ADD(TestInterning::testLimitedEntries);
+    TEST_ADD(TestInterning::testInvalidReference);
+  }
+
+  void testRoundTrip() {
+    auto quotes = createQuotes(1000);
+    std::stringstream ss{};
+    {
+      StringInterningSerializer<S> s{S{ss}};
+      serialize::serialize(s, quotes);
+      testAssertEquals(13U, s.numEntries());
+      s.flush();
+    }
+
+    StringInterningDeserializer<D> d{D{ss}};
+    testAssertEquals(quotes, deserialize<std::vector<Quote>>(d));
+    testAssertEquals(13U, d.numEntries());
+  }
+
+  void testReducesSize() {
+    auto quotes = createQuotes(1000);
+    std::stringstream plain{};
+    {
+      S s{plain};
+      serialize::serialize(s, quotes);
+      s.flush();
+    }
+    std::stringstream interned{};
+    {
+      StringInterningSerializer<S> s{S{interned}};
+      serialize::serialize(s, quotes);
+      s.flush();
+    }
+    testAssert(interned.str().size() < plain.str().size() / 2);
+  }
+
+  void testStringViews() {
+    std::stringstream ss{};
+    {
+      StringInterningSerializer<S> s{S{ss}};
+      serialize::serialize(s, std::string{"first"});
+      serialize::serialize(s, std::string_view{"second"});
+      serialize::serialize(s, std::string{"first"});
+      serialize::serialize(s, std::string_view{"second"});
+      s.flush();
+    }
+
+    StringInterningDeserializer<D> d{D{ss}};
+    auto first = deserialize<std::string_view>(d);
+    auto second = deserialize<std::string_view>(d);
+    testAssertEquals(std::string_view{"first"}, first);
+    testAssertEquals(std::string_view{"second"}, second);
+    // repeated strings reference the same storage
+    testAssertEquals(first.data(), deserialize<std::string_view>(d).data());
+    testAssertEquals(second.data(), deserialize<std::string_view>(d).data());
+  }
+
+  void testNestedStrings() {
+    std::map<std::string, std::vector<std::string>> tags{
+        {"alpha", {"red", "green", "blue"}}, {"beta", {"blue", "alpha"}}, {"gamma", {}}, {"delta", {"red", "red"}}};
+    std::stringstream ss{};
+    {
+      StringInterningSerializer<S> s{S{ss}};
+      serialize::serialize(s, tags);
+      serialize::serialize(s, tags);
+      testAssertEquals(7U, s.numEntries());
+      s.flush();
+    }
+
+    StringInterningDeserializer<D> d{D{ss}};
+    auto first = deserialize<std::map<std::string, std::vector<std::string>>>(d);
+    testAssertEquals(tags, first);
+    auto second = deserialize<std::map<std::string, std::vector<std::string>>>(d);
+    testAssertEquals(tags, second);
+  }
+
+  void testSkipStrings() {
+    auto quotes = createQuotes(50);
+    std::stringstream ss{};
+    {
+      StringInterningSerializer<S> s{S{ss}};
+      serialize::serialize(s, quotes);
+      serialize::serialize(s, quotes);
+      s.flush();
+    }
+
+    StringInterningDeserializer<D> d{D{ss}};
+    // skipped strings still need to be registered to resolve later back-references
+    skip<std::vector<Quote>>(d);
+    testAssertEquals(quotes, deserialize<std::vector<Quote>>(d));
+  }
+
+  void testLimitedEntries() {
+    std::vector<std::string> values{"a", "b", "c", "a", "b", "c", "d", "c"};
+    std::stringstream ss{};
+    {
+      StringInterningSerializer<S> s{S{ss}, 2};
+      serialize::serialize(s, values);
+      testAssertEquals(2U, s.numEntries());
+      s.flush();
+    }
+
+    StringInterningDeserializer<D> d{D{ss}};
+    testAssertEquals(values, deserialize<std::vector<std::string>>(d));
+    testAssertEquals(2U, d.numEntries());
+  }
+
+  void testInvalidReference() {
+    std::stringstream ss{};
+    {
+      S s{ss};
+      serialize::serialize(s, detail::INTERNED_NEW);
+      serialize::serialize(s, std::string{"foo"});
+      // references the second entry, which does not exist
+      serialize::serialize(s, detail::INTERNED_REFERENCE_OFFSET + 1);
+      s.flush();
+    }
+
+    StringInterningDeserializer<D> d{D{ss}};
+    testAssertEquals(std::string{"foo"}, deserialize<std::string>(d));
+    testThrows<std::domain_error>([&] { deserialize<std::string>(d); });
+  }
+
+private:
+  static std::vector<Quote> createQuotes(std::size_t numQuotes) {
+    static const std::vector<std::string> symbols{"AAPL", "MSFT", "GOOG", "AMZN", "NVDA",
+                                                  "META", "TSLA", "ORCL", "INTC", "IBM"};
+    static const std::vector<std::string> exchanges{"NASDAQ Global Select Market", "New York Stock Exchange",
+                                                    "London Stock Exchange"};
+    std::vector<Quote> quotes{};
+    for (std::size_t i = 0; i < numQuotes; ++i) {
+      quotes.push_back(Quote{symbols[i % symbols.size()], exchanges[i % exchanges.size()],
+                             static_cast<uint32_t>(i * 17 % 1000)});
+    }
+    return quotes;
+  }
+};
+
+void registerInterningTests() { registerBackendSuites<TestInterning>("interning", "Interning"); }
@@ -0,0 +1,162 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "lossy.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+#include "streams.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <cmath>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct SensorSample {
+  uint32_t timestamp;
+  Half<float> temperature;
+  Quantized<double, std::centi> pressure;
+  BFloat16<float> humidity;
+  Quantized<float, std::ratio<1, 4>, int16_t> windSpeed;
+};
+
+static_assert(serialize::Serializable<SensorSample>);
+static_assert(serialize::Deserializable<SensorSample>);
+static_assert(!std::is_aggregate_v<Half<float>>);
+
+template <typename S, typename D> class TestLossy : public Test::Suite {
+public:
+  explicit TestLossy(const std::string& name) : Suite(name) {
+    TEST_ADD(TestLossy::testHalf);
+    TEST_ADD(TestLossy::testBFloat16);
+    TEST_ADD(TestLossy::testQuantized);
+    TEST_ADD(TestLossy::testAggregate);
+    TEST_ADD(TestLossy::testSize);
+  }
+
+  void testHalf() {
+    // exactly representable values
+    for (float value : {0.0f, -0.0f, 1.0f, -2.5f, 0.000060975552f, 65504.0f, -65504.0f, 5.9604645e-8f}) {
+      testAssertEquals(value, roundTrip(Half<float>{value}).value());
+    }
+    testAssertEquals(static_cast<double>(1.0009765625), roundTrip(Half<double>{1.0009765625}).value());
+    // rounding to nearest, ties to even
+    testAssertEquals(1.0f, roundTrip(Half<float>{1.00048828125f}).value());
+    testAssertEquals(1.001953125f, roundTrip(Half<float>{1.00146484375f}).value());
+    testAssertEquals(3.140625f, roundTrip(Half<float>{3.14159265f}).value());
+    // out of range
+    testAssertEquals(std::numeric_limits<float>::infinity(), roundTrip(Half<float>{70000.0f}).value());
+    testAssertEquals(-std::numeric_limits<float>::infinity(), roundTrip(Half<float>{-1e10f}).value());
+    testAssertEquals(0.0f, roundTrip(Half<float>{1e-10f}).value());
+    testAssert(std::isnan(roundTrip(Half<float>{std::numeric_limits<float>::quiet_NaN()}).value()));
+
+    // every half-precision value is converted back to the same bits
+    for (uint32_t i = 0; i <= std::numeric_limits<uint16_t>::max(); ++i) {
+      auto value = detail::halfToFloat(static_cast<uint16_t>(i));
+      if (!std::isnan(value) && detail::floatToHalf(value) != i) {
+        testAssertEquals(i, static_cast<uint32_t>(detail::floatToHalf(value)));
+      }
+    }
+  }
+
+  void testBFloat16() {
+    for (float value : {0.0f, -1.0f, 3.0e38f, 1.0e-30f, 123.456f}) {
+      auto result = roundTrip(BFloat16<float>{value}).value();
+      testAssert(std::abs(result - value) <= std::abs(value) / 256);
+    }
+    testAssertEquals(3.140625f, roundTrip(BFloat16<float>{3.14159265f}).value());
+    testAssertEquals(std::numeric_limits<float>::infinity(),
+                     roundTrip(BFloat16<float>{std::numeric_limits<float>::infinity()}).value());
+    testAssertEquals(1.0f, roundTrip(BFloat16<double>{1.001}).value());
+    testAssert(std::isnan(roundTrip(BFloat16<float>{std::numeric_limits<float>::quiet_NaN()}).value()));
+    testAssert(std::isnan(roundTrip(BFloat16<float>{std::bit_cast<float>(0x7F80FFFFU)}).value()));
+  }
+
+  void testQuantized() {
+    testAssertEquals(12.34, roundTrip(Quantized<double, std::centi>{12.3412}).value());
+    testAssertEquals(-12.35, roundTrip(Quantized<double, std::centi>{-12.346}).value());
+    testAssertEquals(1500.0f, roundTrip(Quantized<float, std::ratio<500>>{1337.0f}).value());
+    testAssertEquals(-0.75f, roundTrip(Quantized<float, std::ratio<1, 4>, int8_t>{-0.8f}).value());
+    testAssertEquals(12345678901.0, roundTrip(Quantized<double, std::ratio<1>>{12345678901.4}).value());
+
+    using Small = Quantized<float, std::deci, int8_t>;
+    testAssertEquals(12.7f, roundTrip(Small{12.7f}).value());
+    testAssertEquals(-12.8f, roundTrip(Small{-12.8f}).value());
+    testThrows<std::out_of_range>([]() { Small::quantize(12.8f); });
+    testThrows<std::out_of_range>([]() { Small::quantize(-12.9f); });
+    testThrows<std::out_of_range>([]() { Small::quantize(std::numeric_limits<float>::quiet_NaN()); });
+    testThrows<std::out_of_range>(
+        []() { Quantized<double, std::milli>::quantize(std::numeric_limits<double>::infinity()); });
+    testThrows<std::out_of_range>([]() { Quantized<double, std::milli>::quantize(1e17); });
+  }
+
+  void testAggregate() {
+    SensorSample sample{1700000000, 21.37f, 1013.254, 45.5f, 3.3f};
+    BufferOutputStream out{};
+    {
+      S s{out};
+      serialize::serialize(s, sample);
+      s.flush();
+    }
+    SpanInputStream in{out.data()};
+    D d{in};
+    auto result = deserialize<SensorSample>(d);
+    testAssertEquals(sample.timestamp, result.timestamp);
+    testAssertEquals(21.375f, result.temperature.value());
+    testAssertEquals(1013.25, result.pressure.value());
+    testAssertEquals(45.5f, result.humidity.value());
+    testAssertEquals(3.25f, result.windSpeed.value());
+  }
+
+  void testSize() {
+    std::vector<float> values{};
+    std::vector<Half<float>> halves{};
+    std::vector<BFloat16<float>> bfloats{};
+    std::vector<Quantized<float, std::deci, int16_t>> quantized{};
+    for (int i = 0; i < 1000; ++i) {
+      auto value = 20.0f + 5.0f * std::sin(static_cast<float>(i) * 0.01f) + 0.01f * static_cast<float>(i % 7);
+      values.push_back(value);
+      halves.emplace_back(value);
+      bfloats.emplace_back(value);
+      quantized.emplace_back(value);
+    }
+    auto floatSize = encodedSize(values);
+    testAssert(encodedSize(halves) * 4 <= floatSize * 3);
+    testAssert(encodedSize(bfloats) * 4 <= floatSize * 3);
+    testAssert(encodedSize(quantized) * 3 <= floatSize * 2);
+  }
+
+private:
+  template <typename T> T roundTrip(const T& value) {
+    BufferOutputStream out{};
+    {
+      S s{out};
+      serialize::serialize(s, value);
+      s.flush();
+    }
+    SpanInputStream in{out.data()};
+    D d{in};
+    return deserialize<T>(d);
+  }
+
+  template <typename T> std::size_t encodedSize(const T& value) {
+    BufferOutputStream out{};
+    S s{out};
+    serialize::serialize(s, value);
+    s.flush();
+    return out.data().size();
+  }
+};
+
+void registerLossyTests() { registerBackendSuites<TestLossy>("lossy", "Lossy"); }
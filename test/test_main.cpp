@@ -10,11 +10,45 @@ extern void registerSimpleTests();
 extern void registerBytePackingTests();
 extern void registerBitPackingTests();
 extern void registerTypeSafeTests();
+extern void registerIndexedTests();
+extern void registerFramedTests();
+extern void registerParallelTests();
+extern void registerResumableTests();
+extern void registerAsyncStreamTests();
+extern void registerCompressionTests();
+extern void registerChecksumTests();
+extern void registerInterningTests();
+extern void registerGraphTests();
+extern void registerColumnarTests();
+extern void registerDeltaTests();
+extern void registerTaggedTests();
+extern void registerFixedBufferTests();
+extern void registerBoundedTests();
+extern void registerCodecTests();
+extern void registerInstrumentedTests();
+extern void registerLossyTests();
 
 int main(int argc, char** argv) {
   registerSimpleTests();
   registerBytePackingTests();
   registerBitPackingTests();
   registerTypeSafeTests();
+  registerIndexedTests();
+  registerFramedTests();
+  registerParallelTests();
+  registerResumableTests();
+  registerAsyncStreamTests();
+  registerCompressionTests();
+  registerChecksumTests();
+  registerInterningTests();
+  registerGraphTests();
+  registerColumnarTests();
+  registerDeltaTests();
+  registerTaggedTests();
+  registerFixedBufferTests();
+  registerBoundedTests();
+  registerCodecTests();
+  registerInstrumentedTests();
+  registerLossyTests();
   return Test::runSuites(argc, argv);
 }
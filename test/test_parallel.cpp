@@ -0,0 +1,232 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "parallel.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct ParallelRecord {
+  uint64_t id;
+  std::string name;
+  std::vector<double> values;
+
+  auto operator<=>(const ParallelRecord& other) const noexcept = default;
+};
+
+class TestParallel : public Test::Suite {
+public:
+  TestParallel() : Suite("Parallel") {
+    TEST_ADD(TestParallel::testThreadPool);
+    TEST_ADD(TestParallel::testNestedTasks);
+    TEST_ADD(TestParallel::testOrderedDeserialization);
+    TEST_ADD(TestParallel::testUnorderedDeserialization);
+    TEST_ADD(TestParallel::testConsumer);
+    TEST_ADD(TestParallel::testEmptyStream);
+    TEST_ADD(TestParallel::testErrorPropagation);
+    TEST_ADD(TestParallel::testParallelSerialization);
+    TEST_ADD(TestParallel::testSplicing);
+  }
+
+  void testThreadPool() {
+    std::atomic_size_t counter{0};
+    {
+      ThreadPool pool{4};
+      testAssertEquals(4U, pool.size());
+      for (std::size_t i = 0; i < 1000; ++i) {
+        pool.submit([&counter]() { ++counter; });
+      }
+      // destructor waits for all tasks
+    }
+    testAssertEquals(1000U, counter.load());
+  }
+
+  void testNestedTasks() {
+    std::atomic_size_t counter{0};
+    {
+      ThreadPool pool{3};
+      for (std::size_t i = 0; i < 10; ++i) {
+        pool.submit([&pool, &counter]() {
+          for (std::size_t j = 0; j < 10; ++j) {
+            pool.submit([&counter]() { ++counter; });
+          }
+        });
+      }
+    }
+    testAssertEquals(100U, counter.load());
+  }
+
+  void testOrderedDeserialization() {
+    auto records = createRecords(5000);
+    auto ss = writeRecords<SimpleStreamSerializer>(records);
+    ThreadPool pool{4};
+    auto results = parallelDeserialize<ParallelRecord, SimpleStreamDeserializer>(ss, pool, ResultOrder::ORDERED, 64);
+    testAssertEquals(records, results);
+  }
+
+  void testUnorderedDeserialization() {
+    auto records = createRecords(5000);
+    auto ss = writeRecords<BitPackingSinkSerializer>(records);
+    ThreadPool pool{4};
+    auto results =
+        parallelDeserialize<ParallelRecord, BitPackingSourceDeserializer>(ss, pool, ResultOrder::UNORDERED, 100);
+    testAssertEquals(records.size(), results.size());
+    std::sort(results.begin(), results.end());
+    testAssertEquals(records, results);
+  }
+
+  void testConsumer() {
+    auto records = createRecords(3000);
+    auto ss = writeRecords<BytePackingSinkSerializer>(records);
+    ThreadPool pool{2};
+    std::size_t index = 0;
+    bool inOrder = true;
+    parallelDeserialize<ParallelRecord, BytePackingSourceDeserializer>(ss, pool, [&](ParallelRecord&& record) {
+      inOrder = inOrder && record == records.at(index);
+      ++index;
+    });
+    testAssertEquals(records.size(), index);
+    testAssert(inOrder);
+  }
+
+  void testEmptyStream() {
+    std::stringstream ss{};
+    ThreadPool pool{2};
+    auto results = parallelDeserialize<ParallelRecord, SimpleStreamDeserializer>(ss, pool);
+    testAssert(results.empty());
+  }
+
+  void testErrorPropagation() {
+    auto records = createRecords(1000);
+    ThreadPool pool{4};
+    {
+      // truncated stream, detected when reading the frames
+      auto data = writeRecords<SimpleStreamSerializer>(records).str();
+      std::stringstream ss{data.substr(0, data.size() - 3)};
+      testThrows<std::out_of_range>([&]() {
+        std::ignore = parallelDeserialize<ParallelRecord, SimpleStreamDeserializer>(ss, pool, ResultOrder::ORDERED, 10);
+      });
+    }
+    {
+      // records decoded as wrong type, detected when decoding the records
+      auto ss = writeRecords<SimpleStreamSerializer>(records);
+      testThrows<std::out_of_range>([&]() {
+        std::ignore = parallelDeserialize<FundamentalTypes, SimpleStreamDeserializer>(ss, pool, ResultOrder::UNORDERED);
+      });
+    }
+    {
+      // exception thrown by the consumer
+      auto ss = writeRecords<SimpleStreamSerializer>(records);
+      testThrows<std::runtime_error>([&]() {
+        parallelDeserialize<ParallelRecord, SimpleStreamDeserializer>(ss, pool, [](ParallelRecord&& record) {
+          if (record.id == 500) {
+            throw std::runtime_error{"Consumer error"};
+          }
+        });
+      });
+    }
+  }
+
+  void testParallelSerialization() {
+    ThreadPool pool{4};
+    auto records = createRecords(5000);
+    std::vector<int32_t> numbers{};
+    for (int32_t i = 0; i < 10000; ++i) {
+      numbers.push_back(i % 2 ? i * i : -i);
+    }
+
+    checkParallelSerialization<SimpleStreamSerializer, SimpleStreamDeserializer>(pool, records, 64);
+    checkParallelSerialization<SimpleStreamSerializer, SimpleStreamDeserializer>(pool, numbers, 1000);
+    checkParallelSerialization<BitPackingSinkSerializer, BitPackingSourceDeserializer>(pool, records, 77);
+    checkParallelSerialization<BitPackingSinkSerializer, BitPackingSourceDeserializer>(pool, numbers, 333);
+    checkParallelSerialization<BytePackingSinkSerializer, BytePackingSourceDeserializer>(pool, records, 100);
+    checkParallelSerialization<BytePackingSinkSerializer, BytePackingSourceDeserializer>(pool, numbers, 1);
+    // smaller than a single chunk
+    checkParallelSerialization<BitPackingSinkSerializer, BitPackingSourceDeserializer>(pool, numbers, 100000);
+  }
+
+  void testSplicing() {
+    // splice not byte-aligned data into not byte-aligned serializer
+    std::stringstream sequential{};
+    {
+      BitPackingSinkSerializer serializer{sequential};
+      serialize::serialize(serializer, uint32_t{5});
+      serialize::serialize(serializer, int64_t{-1234567});
+      serialize::serialize(serializer, true);
+      serialize::serialize(serializer, 1.0);
+      serializer.flush();
+    }
+    std::stringstream spliced{};
+    {
+      BitPackingSinkSerializer serializer{spliced};
+      serialize::serialize(serializer, uint32_t{5});
+      BufferOutputStream buffer{};
+      BitPackingSinkSerializer other{buffer};
+      serialize::serialize(other, int64_t{-1234567});
+      serialize::serialize(other, true);
+      serializer.splice(std::move(other), buffer.data());
+      serialize::serialize(serializer, 1.0);
+      serializer.flush();
+    }
+    testAssertEquals(sequential.str(), spliced.str());
+  }
+
+private:
+  template <typename S, typename D, typename C>
+  void checkParallelSerialization(ThreadPool& pool, const C& container, std::size_t elementsPerChunk) {
+    std::stringstream sequential{};
+    {
+      S serializer{sequential};
+      serialize::serialize(serializer, container);
+      serialize::serialize(serializer, uint8_t{17});
+      serializer.flush();
+    }
+    std::stringstream parallel{};
+    {
+      S serializer{parallel};
+      parallelSerialize(serializer, container, pool, elementsPerChunk);
+      serialize::serialize(serializer, uint8_t{17});
+      serializer.flush();
+    }
+    testAssertEquals(sequential.str(), parallel.str());
+    D deserializer{parallel};
+    testAssertEquals(container, deserialize<C>(deserializer));
+    testAssertEquals(17U, deserialize<uint8_t>(deserializer));
+  }
+
+  static std::vector<ParallelRecord> createRecords(std::size_t numRecords) {
+    std::vector<ParallelRecord> records{};
+    for (std::size_t i = 0; i < numRecords; ++i) {
+      records.push_back(ParallelRecord{i, "Record #" + std::to_string(i), std::vector<double>(i % 7, 1.5 * i)});
+    }
+    return records;
+  }
+
+  template <typename S> static std::stringstream writeRecords(const std::vector<ParallelRecord>& records) {
+    std::stringstream ss{};
+    FramedStreamWriter<S> writer{ss};
+    for (const auto& record : records) {
+      writer.write(record);
+    }
+    writer.flush();
+    return ss;
+  }
+};
+
+void registerParallelTests() { Test::registerSuite(Test::newInstance<TestParallel>, "parallel"); }
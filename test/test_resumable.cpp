@@ -0,0 +1,196 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "resumable.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+using namespace serialize;
+
+struct ResumableMessage {
+  uint32_t id;
+  std::string name;
+  FundamentalTypes fundamentals;
+  std::vector<std::pair<int16_t, std::string>> entries;
+  std::array<double, 3> position;
+  std::bitset<17> flags;
+  std::variant<int, std::string, std::vector<float>> payload;
+  std::chrono::milliseconds timeout;
+
+  auto operator<=>(const ResumableMessage& other) const noexcept = default;
+};
+
+/**
+ * Deserializer failing all reads while the flag is set, e.g. simulating an error in the underlying source.
+ */
+template <typename D> class FailingDeserializer : public D {
+public:
+  using D::D;
+
+  template <typename T> bool tryRead(T& val) {
+    if (failReads) {
+      throw std::domain_error{"Read failed"};
+    }
+    return D::tryRead(val);
+  }
+
+  inline static bool failReads = false;
+};
+
+template <typename S, typename D> class TestResumableDeserialization : public Test::Suite {
+public:
+  explicit TestResumableDeserialization(const std::string& name) : Suite(name) {
+    TEST_ADD(TestResumableDeserialization::testCompleteData);
+    TEST_ADD(TestResumableDeserialization::testByteWiseFeeding);
+    TEST_ADD(TestResumableDeserialization::testChunkedFeeding);
+    TEST_ADD(TestResumableDeserialization::testMultipleValues);
+    TEST_ADD(TestResumableDeserialization::testStandardTypes);
+    TEST_ADD(TestResumableDeserialization::testErrors);
+    TEST_ADD(TestResumableDeserialization::testErrorOnRetry);
+  }
+
+  void testCompleteData() {
+    auto data = serializeValues(MESSAGE);
+    ResumableDeserializer<ResumableMessage, D> deserializer{};
+    testAssertEquals(ResumeStatus::COMPLETE, deserializer.feed(data));
+    testAssertEquals(MESSAGE, deserializer.take());
+    testAssertEquals(0U, deserializer.numBuffered());
+  }
+
+  void testByteWiseFeeding() {
+    auto data = serializeValues(MESSAGE);
+    ResumableDeserializer<ResumableMessage, D> deserializer{};
+    for (std::size_t i = 0; i + 1 < data.size(); ++i) {
+      testAssertEquals(ResumeStatus::NEED_MORE_DATA, deserializer.feed(std::span{data}.subspan(i, 1)));
+      // the buffered data never exceeds a single (partial) value
+      testAssert(deserializer.numBuffered() <= 2 * sizeof(long double));
+    }
+    testAssertEquals(ResumeStatus::COMPLETE, deserializer.feed(std::span{data}.last(1)));
+    testAssertEquals(MESSAGE, deserializer.take());
+  }
+
+  void testChunkedFeeding() {
+    auto data = serializeValues(MESSAGE);
+    for (std::size_t chunkSize : {3U, 7U, 16U, 100U}) {
+      ResumableDeserializer<ResumableMessage, D> deserializer{};
+      auto status = ResumeStatus::NEED_MORE_DATA;
+      for (std::size_t i = 0; i < data.size(); i += chunkSize) {
+        testAssertEquals(ResumeStatus::NEED_MORE_DATA, status);
+        status = deserializer.feed(std::span{data}.subspan(i, std::min(chunkSize, data.size() - i)));
+      }
+      testAssertEquals(ResumeStatus::COMPLETE, status);
+      testAssertEquals(MESSAGE, deserializer.take());
+    }
+  }
+
+  void testMultipleValues() {
+    auto data = serializeValues(MESSAGE, ResumableMessage{}, MESSAGE);
+    ResumableDeserializer<ResumableMessage, D> deserializer{};
+    testAssertEquals(ResumeStatus::COMPLETE, deserializer.feed(std::span{data}.first(data.size() - 1)));
+    testAssertEquals(MESSAGE, deserializer.take());
+    testThrows<std::logic_error>([&]() { deserializer.take(); });
+    testAssertEquals(ResumeStatus::COMPLETE, deserializer.feed({}));
+    testThrows<std::logic_error>([&]() { deserializer.feed({}); });
+    testAssertEquals(ResumableMessage{}, deserializer.take());
+    testAssertEquals(ResumeStatus::NEED_MORE_DATA, deserializer.feed({}));
+    testAssertEquals(ResumeStatus::COMPLETE, deserializer.feed(std::span{data}.last(1)));
+    testAssertEquals(MESSAGE, deserializer.take());
+  }
+
+  void testStandardTypes() {
+    checkByteWise(std::map<std::string, std::vector<int64_t>>{{"foo", {1, -2, 3}}, {"bar", {}}, {"baz", {-17}}});
+    checkByteWise(std::make_tuple(std::optional<std::string>{"foo"}, std::optional<int>{}, std::complex<float>{1, -2}));
+    checkByteWise(std::make_pair(std::byte{0x17}, std::string{"Some longer string not fitting into SSO buffer"}));
+    checkByteWise(std::bitset<123>{"101100111000111100001111100000111111000000"});
+    checkByteWise(std::vector<bool>{true, false, true, true, false, false, false, true, true, false, true});
+    checkByteWise(std::chrono::system_clock::time_point{std::chrono::seconds{1234567890}});
+    checkByteWise(-1.5L);
+    checkByteWise(std::vector<std::variant<int, std::string>>{42, "foo", -1, "bar"});
+  }
+
+  void testErrors() {
+    auto data = serializeValues(std::size_t{17}, std::string{"foo"});
+    ResumableDeserializer<std::variant<int, std::string>, D> deserializer{};
+    testThrows<std::runtime_error>([&]() { deserializer.feed(data); });
+
+    // more elements than fit into the fixed-size container
+    data = serializeValues(std::vector<uint32_t>{1, 2, 3, 4});
+    ResumableDeserializer<std::array<uint32_t, 3>, D> arrayDeserializer{};
+    testThrows<std::out_of_range>([&]() { arrayDeserializer.feed(data); });
+    // less elements than the fixed-size container has
+    data = serializeValues(std::vector<uint32_t>{1, 2});
+    ResumableDeserializer<std::array<uint32_t, 3>, D> otherDeserializer{};
+    testThrows<std::out_of_range>([&]() { otherDeserializer.feed(data); });
+  }
+
+  void testErrorOnRetry() {
+    using Deserializer = FailingDeserializer<D>;
+    auto data = serializeValues(std::make_tuple(uint32_t{1}, uint32_t{123456}));
+    ResumableDeserializer<std::tuple<uint32_t, uint32_t>, Deserializer> deserializer{};
+    testAssertEquals(ResumeStatus::NEED_MORE_DATA, deserializer.feed(std::span{data}.first(data.size() - 1)));
+    // the error is only thrown when retrying the read of the second element
+    Deserializer::failReads = true;
+    testThrows<std::domain_error>([&]() { deserializer.feed(std::span{data}.last(1)); });
+    Deserializer::failReads = false;
+    // the partially deserialized value is dropped, the unread second element starts a new value
+    testAssertEquals(ResumeStatus::NEED_MORE_DATA, deserializer.feed({}));
+  }
+
+private:
+  template <typename T> void checkByteWise(const T& value) {
+    auto data = serializeValues(value);
+    ResumableDeserializer<T, D> deserializer{};
+    auto status = ResumeStatus::NEED_MORE_DATA;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      testAssertEquals(ResumeStatus::NEED_MORE_DATA, status);
+      status = deserializer.feed(std::span{data}.subspan(i, 1));
+    }
+    testAssertEquals(ResumeStatus::COMPLETE, status);
+    testAssertEquals(value, deserializer.take());
+  }
+
+  template <typename... Args> static std::vector<std::byte> serializeValues(const Args&... values) {
+    std::stringstream ss{};
+    S serializer{ss};
+    (serialize::serialize(serializer, values), ...);
+    serializer.flush();
+    auto string = ss.str();
+    auto bytes = std::as_bytes(std::span{string});
+    return std::vector<std::byte>{bytes.begin(), bytes.end()};
+  }
+
+  inline static const ResumableMessage MESSAGE{
+      17,
+      "Some name",
+      {-3, 17, -1234, 12345, -654321, 543213440, -3751985643563665, 43759353465875, -17.0f, 4365477356385674763.34563,
+       4357357985453435.43568463578623562, 'a', L'b', u8'A', u'c', U'd', true},
+      {{1, "One"}, {-2, "Two"}, {1234, ""}},
+      {1.0, -2.5, 1e100},
+      std::bitset<17>{0x1A2B3},
+      std::vector<float>{1.0f, -0.5f},
+      std::chrono::milliseconds{12345},
+  };
+};
+
+void registerResumableTests() { registerBackendSuites<TestResumableDeserialization>("resumable", "Resumable"); }
@@ -0,0 +1,238 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#include "tagged.hpp"
+
+#include "bit_packing.hpp"
+#include "byte_packing.hpp"
+#include "simple.hpp"
+
+#include "cpptest.h"
+#include "test_base.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace serialize;
+
+struct Point {
+  int32_t x;
+  int32_t y;
+
+  auto operator<=>(const Point& other) const noexcept = default;
+};
+
+struct AddressV1 {
+  std::string street;
+  std::string city;
+
+  static constexpr std::array<uint32_t, 2> fieldNumbers{1, 2};
+
+  auto operator<=>(const AddressV1& other) const noexcept = default;
+};
+
+struct AddressV2 {
+  std::string city;
+  uint32_t zipCode;
+
+  static constexpr std::array<uint32_t, 2> fieldNumbers{2, 3};
+
+  auto operator<=>(const AddressV2& other) const noexcept = default;
+};
+
+struct CustomerV1 {
+  uint64_t id;
+  std::string name;
+  double balance;
+  AddressV1 address;
+  Point location;
+
+  auto operator<=>(const CustomerV1& other) const noexcept = default;
+};
+
+struct CustomerV2 {
+  // added member
+  std::vector<std::string> tags;
+  uint64_t id;
+  std::string name;
+  // balance removed
+  Point location;
+  AddressV2 address;
+
+  static constexpr std::array<uint32_t, 5> fieldNumbers{6, 1, 2, 5, 4};
+
+  auto operator<=>(const CustomerV2& other) const noexcept = default;
+};
+
+struct Archived {
+  uint64_t id;
+  std::vector<uint32_t> history;
+  std::string comment;
+
+  auto operator<=>(const Archived& other) const noexcept = default;
+};
+
+struct Summary {
+  uint64_t id;
+  std::string comment;
+
+  static constexpr std::array<uint32_t, 2> fieldNumbers{1, 3};
+
+  auto operator<=>(const Summary& other) const noexcept = default;
+};
+
+static_assert(TaggedRecord<CustomerV1>);
+static_assert(ExplicitlyTaggedRecord<CustomerV2>);
+static_assert(!ExplicitlyTaggedRecord<CustomerV1>);
+static_assert(!TaggedRecord<std::string>);
+
+template <typename S, typename D> class TestTagged : public Test::Suite {
+public:
+  explicit TestTagged(const std::string& name) : Suite(name) {
+    TEST_ADD(TestTagged::testRoundTrip);
+    TEST_ADD(TestTagged::testReadNewerVersion);
+    TEST_ADD(TestTagged::testReadOlderVersion);
+    TEST_ADD(TestTagged::testSkipUnknownFields);
+    TEST_ADD(TestTagged::testSkipRecords);
+    TEST_ADD(TestTagged::testInvalidField);
+    TEST_ADD(TestTagged::testMaxFrameSize);
+  }
+
+  void testRoundTrip() {
+    CustomerV1 customer{17, "Alice", 42.5, {"Main Street 1", "Springfield"}, {3, -4}};
+    std::stringstream ss{};
+    {
+      TaggedRecordWriter<S> writer{ss};
+      writer.write(customer);
+      writer.write(CustomerV1{});
+      writer.flush();
+    }
+
+    TaggedRecordReader<D> reader{ss};
+    testAssertEquals(customer, reader.template read<CustomerV1>().value());
+    testAssertEquals(CustomerV1{}, reader.template read<CustomerV1>().value());
+    testAssert(!reader.template read<CustomerV1>());
+  }
+
+  void testReadNewerVersion() {
+    CustomerV1 customer{17, "Alice", 42.5, {"Main Street 1", "Springfield"}, {3, -4}};
+    std::stringstream ss{};
+    {
+      TaggedRecordWriter<S> writer{ss};
+      writer.write(customer);
+      writer.write(customer);
+      writer.flush();
+    }
+
+    TaggedRecordReader<D> reader{ss};
+    CustomerV2 result{{"default"}, 0, "", {}, {"", 12345}};
+    testAssert(reader.readInto(result));
+    // missing fields keep their values, fields of removed members are ignored
+    testAssertEquals((CustomerV2{{"default"}, 17, "Alice", {3, -4}, {"Springfield", 12345}}), result);
+    // missing fields are default-initialized
+    testAssertEquals((CustomerV2{{}, 17, "Alice", {3, -4}, {"Springfield", 0}}),
+                     reader.template read<CustomerV2>().value());
+  }
+
+  void testReadOlderVersion() {
+    CustomerV2 customer{{"premium", "new"}, 99, "Bob", {-7, 8}, {"Shelbyville", 54321}};
+    std::stringstream ss{};
+    {
+      TaggedRecordWriter<S> writer{ss};
+      writer.write(customer);
+      writer.flush();
+    }
+
+    TaggedRecordReader<D> reader{ss};
+    testAssertEquals((CustomerV1{99, "Bob", 0.0, {"", "Shelbyville"}, {-7, 8}}),
+                     reader.template read<CustomerV1>().value());
+  }
+
+  void testSkipUnknownFields() {
+    Archived archived{1234, std::vector<uint32_t>(100000, 0xDEADBEEF), "archived"};
+    std::stringstream ss{};
+    {
+      TaggedRecordWriter<S> writer{ss};
+      writer.write(archived);
+      writer.write(Archived{5678, {1, 2, 3}, "second"});
+      writer.flush();
+    }
+
+    TaggedRecordReader<D> reader{ss};
+    testAssertEquals((Summary{1234, "archived"}), reader.template read<Summary>().value());
+    testAssertEquals((Summary{5678, "second"}), reader.template read<Summary>().value());
+  }
+
+  void testSkipRecords() {
+    std::stringstream ss{};
+    {
+      TaggedRecordWriter<S> writer{ss};
+      for (uint32_t i = 0; i < 10; ++i) {
+        writer.write(Point{static_cast<int32_t>(i), -static_cast<int32_t>(i)});
+      }
+      writer.flush();
+    }
+
+    TaggedRecordReader<D> reader{ss};
+    testAssertEquals(7U, reader.skip(7));
+    testAssertEquals((Point{7, -7}), reader.template read<Point>().value());
+    testAssertEquals(2U, reader.skip(5));
+    testAssert(!reader.template read<Point>());
+  }
+
+  void testInvalidField() {
+    std::stringstream fields{};
+    {
+      BytePackingSinkSerializer s{fields};
+      // field 1 with a size exceeding the record
+      s.write(uint32_t{1});
+      s.write(std::size_t{100});
+      s.write(uint32_t{42});
+      s.flush();
+    }
+    std::stringstream ss{};
+    {
+      BytePackingSinkSerializer s{ss};
+      s.write(fields.str().size());
+      s.flush();
+      ss << fields.str();
+    }
+
+    TaggedRecordReader<D> reader{ss};
+    testThrows<std::domain_error>([&] { reader.template read<Point>(); });
+  }
+
+  void testMaxFrameSize() {
+    {
+      // huge record size with a single field byte, must not try to allocate the record
+      std::stringstream ss{};
+      BytePackingSinkSerializer header{ss};
+      header.write(uint64_t{1} << 56U);
+      header.flush();
+      ss << 'a';
+
+      TaggedRecordReader<D> reader{ss};
+      testThrows<std::domain_error>([&] { reader.template read<Point>(); });
+    }
+    std::stringstream ss{};
+    {
+      TaggedRecordWriter<S> writer{ss};
+      writer.write(Point{1000000, -1000000});
+      writer.flush();
+    }
+    {
+      std::stringstream copy{ss.str()};
+      TaggedRecordReader<D> reader{copy, 2};
+      testThrows<std::domain_error>([&] { reader.template read<Point>(); });
+    }
+    TaggedRecordReader<D> reader{ss, 64};
+    testAssertEquals((Point{1000000, -1000000}), reader.template read<Point>().value());
+  }
+};
+
+void registerTaggedTests() { registerBackendSuites<TestTagged>("tagged", "Tagged"); }